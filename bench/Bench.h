@@ -0,0 +1,52 @@
+#pragma once
+/// @copyright {2024, Russell J. Fleming. All rights reserved.}
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+#include    <chrono>
+#include    <cstddef>
+#include    <format>
+#include    <iostream>
+#include    <string_view>
+
+namespace pentifica::tbox::bench {
+    /// @brief  Keeps the compiler from discarding a computed value
+    /// @param  value   The value to keep
+    template<typename T>
+    void DoNotOptimize(T const& value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+    /// @brief  Times an action
+    /// @param  action  The action to time
+    /// @return The elapsed time in nanoseconds
+    template<typename Action>
+    double ElapsedNs(Action&& action) {
+        auto const start = std::chrono::steady_clock::now();
+        action();
+        auto const stop = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(stop - start).count();
+    }
+    /// @brief  Prints a benchmark result
+    /// @param  name    The benchmark name
+    /// @param  ops     Number of operations timed
+    /// @param  elapsed_ns  Time taken by the operations
+    inline void Report(std::string_view name, std::size_t ops, double elapsed_ns) {
+        std::cout << std::format("{:<52} {:>10.1f} ns/op {:>14.0f} ops/s\n",
+            name, elapsed_ns / ops, ops * 1e9 / elapsed_ns);
+    }
+}
@@ -0,0 +1,79 @@
+#include    "Bench.h"
+
+#include    <RingBuffer.h>
+
+#include    <cstdint>
+#include    <format>
+#include    <mutex>
+#include    <string_view>
+#include    <thread>
+
+namespace {
+    using namespace pentifica::tbox;
+    using namespace pentifica::tbox::bench;
+
+    constexpr std::size_t capacity{1024};
+    constexpr std::size_t nbr_messages{1 << 24};
+    constexpr std::size_t nbr_round_trips{1 << 16};
+
+    /// @brief  A market data sized message
+    struct Message {
+        std::uint64_t sequence_{};
+        std::uint64_t payload_[3]{};
+    };
+
+    /// @brief  Push until the ring takes the message, giving up the core
+    ///         while it is full
+    template<typename Ring>
+    void Send(Ring& ring, Message const& message) {
+        while(!ring.TryPush(message)) std::this_thread::yield();
+    }
+    /// @brief  Pop the next message, giving up the core while the ring is empty
+    template<typename Ring>
+    Message Receive(Ring& ring) {
+        for(;;) {
+            if(auto message = ring.TryPop()) return *message;
+            std::this_thread::yield();
+        }
+    }
+
+    /// @brief  One producer streaming messages to one consumer
+    template<typename Ring>
+    void BenchThroughput(std::string_view name) {
+        Ring ring(capacity);
+        std::uint64_t sum{};
+        auto const elapsed = ElapsedNs([&] {
+            std::jthread consumer([&] {
+                for(std::size_t i = 0; i < nbr_messages; ++i) sum += Receive(ring).sequence_;
+            });
+            for(std::size_t i = 0; i < nbr_messages; ++i) Send(ring, Message{i});
+        });
+        DoNotOptimize(sum);
+        Report(std::format("{} throughput (1P/1C)", name), nbr_messages, elapsed);
+    }
+
+    /// @brief  A message bounced between two threads over a pair of rings
+    template<typename Ring>
+    void BenchLatency(std::string_view name) {
+        Ring ping(capacity);
+        Ring pong(capacity);
+        auto const elapsed = ElapsedNs([&] {
+            std::jthread echo([&] {
+                for(std::size_t i = 0; i < nbr_round_trips; ++i) Send(pong, Receive(ping));
+            });
+            for(std::size_t i = 0; i < nbr_round_trips; ++i) {
+                Send(ping, Message{i});
+                DoNotOptimize(Receive(pong));
+            }
+        });
+        Report(std::format("{} round trip", name), nbr_round_trips, elapsed);
+    }
+}
+
+int main() {
+    BenchThroughput<RingBuffer<Message>>("RingBuffer<std::mutex>");
+    BenchThroughput<RingBuffer<Message, RingBufferSpsc>>("RingBuffer<RingBufferSpsc>");
+    BenchLatency<RingBuffer<Message>>("RingBuffer<std::mutex>");
+    BenchLatency<RingBuffer<Message, RingBufferSpsc>>("RingBuffer<RingBufferSpsc>");
+    return 0;
+}
@@ -0,0 +1,446 @@
+#include    "Bench.h"
+
+#include    <SkipList.h>
+#include    <SkipListGen.h>
+#include    <SkipListFile.h>
+#include    <ShardedSkipList.h>
+#include    <BlockSkipList.h>
+
+#include    <algorithm>
+#include    <atomic>
+#include    <chrono>
+#include    <cstdint>
+#include    <cstdlib>
+#include    <new>
+#include    <random>
+#include    <ranges>
+#include    <thread>
+#include    <vector>
+
+//  count every heap allocation made by the process
+namespace {
+    std::atomic<std::size_t> allocations{};
+}
+
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if(auto block = std::malloc(size)) return block;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    auto align = static_cast<std::size_t>(alignment);
+    if(auto block = std::aligned_alloc(align, (size + align - 1) / align * align)) return block;
+    throw std::bad_alloc();
+}
+void operator delete(void* block) noexcept { std::free(block); }
+void operator delete(void* block, std::size_t) noexcept { std::free(block); }
+void operator delete(void* block, std::align_val_t) noexcept { std::free(block); }
+void operator delete(void* block, std::size_t, std::align_val_t) noexcept { std::free(block); }
+
+namespace {
+    using namespace pentifica::tbox;
+    using namespace pentifica::tbox::bench;
+
+    constexpr int max_level{20};
+    constexpr std::size_t list_size{1 << 18};
+    constexpr std::size_t nbr_ops{1 << 20};
+    //  every list is built with the same tower layout on every run
+    constexpr std::uint64_t level_seed{0x5eed};
+
+    using Key = std::uint64_t;
+    using Value = std::uint64_t;
+    using SkipListType = SkipList<Key, Value>;
+    /// @brief  A policy whose searches prefetch
+    struct Prefetching : SkipListPolicy {
+        static constexpr bool prefetching{true};
+    };
+
+    /// @brief  Random keys from the range 0 .. limit-1
+    std::vector<Key> RandomKeys(std::size_t count, Key limit, unsigned seed) {
+        std::mt19937_64 rng(seed);
+        std::uniform_int_distribution<Key> distribution(0, limit - 1);
+        std::vector<Key> keys(count);
+        for(auto& key : keys) key = distribution(rng);
+        return keys;
+    }
+
+    /// @brief  Updates of keys already in the list must not allocate
+    void BenchUpdate() {
+        SkipListType skip_list(max_level, SkipListLevelGenerator(.5, level_seed));
+        for(Key key = 0; key < list_size; ++key) {
+            skip_list.Insert(key, key);
+        }
+        auto const keys = RandomKeys(nbr_ops, list_size, 1);
+
+        auto const before = allocations.load();
+        auto const elapsed = ElapsedNs([&] {
+            for(auto key : keys) DoNotOptimize(skip_list.Insert(key, key + 1));
+        });
+        auto const allocated = allocations.load() - before;
+
+        Report("SkipList::Insert (update existing key)", nbr_ops, elapsed);
+        std::cout << std::format("{:<52} {:>10.3f} allocations/op\n", "",
+            static_cast<double>(allocated) / nbr_ops);
+    }
+
+    /// @brief  Deletes and re-inserts reuse arena storage
+    void BenchChurn() {
+        SkipListType skip_list(max_level, SkipListLevelGenerator(.5, level_seed));
+        for(Key key = 0; key < list_size; ++key) {
+            skip_list.Insert(key, key);
+        }
+        auto const keys = RandomKeys(nbr_ops, list_size, 2);
+
+        auto const before = allocations.load();
+        auto const elapsed = ElapsedNs([&] {
+            for(auto key : keys) {
+                skip_list.Delete(key);
+                skip_list.Insert(key, key);
+            }
+        });
+        auto const allocated = allocations.load() - before;
+
+        Report("SkipList::Delete + Insert", 2 * nbr_ops, elapsed);
+        std::cout << std::format("{:<52} {:>10.3f} allocations/op\n", "",
+            static_cast<double>(allocated) / (2 * nbr_ops));
+    }
+
+    /// @brief  Rebuilding a list from sorted input
+    void BenchWarmStart() {
+        constexpr std::size_t load_size{1 << 21};
+        std::vector<std::pair<Key, Value>> kv_pairs;
+        kv_pairs.reserve(load_size);
+        for(Key key = 0; key < load_size; ++key) {
+            kv_pairs.emplace_back(key, key);
+        }
+
+        {
+            SkipListType skip_list(max_level, SkipListLevelGenerator(.5, level_seed));
+            auto const elapsed = ElapsedNs([&] {
+                for(auto const& [key, value] : kv_pairs) skip_list.Insert(key, value);
+            });
+            Report("SkipList::Insert (ascending keys)", load_size, elapsed);
+        }
+        {
+            SkipListType skip_list(max_level, SkipListLevelGenerator(.5, level_seed));
+            auto const elapsed = ElapsedNs([&] { skip_list.BulkLoad(kv_pairs); });
+            Report("SkipList::BulkLoad", load_size, elapsed);
+        }
+    }
+
+    /// @brief  Sorted batches of nearby keys
+    void BenchBatches() {
+        constexpr std::size_t batch_size{1 << 16};
+        constexpr Key spread{8};
+        SkipListType skip_list(max_level, SkipListLevelGenerator(.5, level_seed));
+        for(Key key = 0; key < 4 * list_size; key += 2) {
+            skip_list.Insert(key, key);
+        }
+
+        //  a batch covers a window of the key space with small gaps
+        auto keys = RandomKeys(batch_size, batch_size * spread, 3);
+        std::sort(keys.begin(), keys.end());
+        for(auto& key : keys) key += list_size;
+
+        auto const find_elapsed = ElapsedNs([&] {
+            for(auto key : keys) DoNotOptimize(skip_list.Find(key));
+        });
+        Report("SkipList::Find (sorted batch)", batch_size, find_elapsed);
+        auto const batch_elapsed = ElapsedNs([&] { DoNotOptimize(skip_list.FindBatch(keys)); });
+        Report("SkipList::FindBatch", batch_size, batch_elapsed);
+        std::cout << std::format("{:<52} {:>10.2f}x\n", "", find_elapsed / batch_elapsed);
+
+        std::vector<std::pair<Key, Value>> kv_pairs;
+        for(auto key : keys) kv_pairs.emplace_back(key | 1, key);
+        kv_pairs.erase(std::unique(kv_pairs.begin(), kv_pairs.end()), kv_pairs.end());
+        {
+            SkipListType target(max_level, SkipListLevelGenerator(.5, level_seed));
+            target.BulkLoad(std::views::transform(std::views::iota(Key{}, Key{4 * list_size / 2}),
+                [](Key key) { return std::pair<Key, Value>(2 * key, key); }));
+            auto const elapsed = ElapsedNs([&] {
+                for(auto const& [key, value] : kv_pairs) target.Insert(key, value);
+            });
+            Report("SkipList::Insert (sorted batch)", kv_pairs.size(), elapsed);
+        }
+        {
+            SkipListType target(max_level, SkipListLevelGenerator(.5, level_seed));
+            target.BulkLoad(std::views::transform(std::views::iota(Key{}, Key{4 * list_size / 2}),
+                [](Key key) { return std::pair<Key, Value>(2 * key, key); }));
+            auto const elapsed = ElapsedNs([&] { target.InsertBatch(kv_pairs); });
+            Report("SkipList::InsertBatch", kv_pairs.size(), elapsed);
+        }
+    }
+
+    /// @brief  Insert throughput with the type erased and the inlined generators
+    void BenchLevelGenerators() {
+        auto const keys = RandomKeys(nbr_ops, Key{1} << 40, 4);
+        {
+            SkipListType skip_list(max_level, SkipListLevelGenerator(.5, level_seed));
+            auto const elapsed = ElapsedNs([&] {
+                for(auto key : keys) skip_list.Insert(key, key);
+            });
+            Report("SkipList::Insert (SkipListLevelGenerator)", nbr_ops, elapsed);
+        }
+        {
+            using FastSkipListType = SkipList<Key, Value, std::less<Key>, SkipListPolicy,
+                SkipListFastLevelGenerator<>>;
+            FastSkipListType skip_list(max_level, SkipListFastLevelGenerator<>(level_seed));
+            auto const elapsed = ElapsedNs([&] {
+                for(auto key : keys) skip_list.Insert(key, key);
+            });
+            Report("SkipList::Insert (SkipListFastLevelGenerator)", nbr_ops, elapsed);
+        }
+
+        //  the generators on their own
+        constexpr std::size_t draws{1 << 24};
+        {
+            SkipListLevelGenerator generator(.5, level_seed);
+            auto const elapsed = ElapsedNs([&] {
+                for(std::size_t i = 0; i < draws; ++i) DoNotOptimize(generator(max_level));
+            });
+            Report("SkipListLevelGenerator", draws, elapsed);
+        }
+        {
+            SkipListFastLevelGenerator<> generator(level_seed);
+            auto const elapsed = ElapsedNs([&] {
+                for(std::size_t i = 0; i < draws; ++i) DoNotOptimize(generator(max_level));
+            });
+            Report("SkipListFastLevelGenerator", draws, elapsed);
+        }
+    }
+
+    /// @brief  Lookups in lists started with too few and too many levels
+    void BenchLevelGrowth() {
+        auto const keys = RandomKeys(nbr_ops, list_size, 5);
+        for(auto initial_levels : {2, 18, 32}) {
+            SkipListType skip_list(initial_levels, SkipListLevelGenerator(.5, level_seed));
+            for(Key key = 0; key < list_size; ++key) {
+                skip_list.Insert(key, key);
+            }
+            auto const elapsed = ElapsedNs([&] {
+                for(auto key : keys) DoNotOptimize(skip_list.Find(key));
+            });
+            Report(std::format("SkipList::Find (initial max_level {})", initial_levels), nbr_ops, elapsed);
+        }
+    }
+
+    /// @brief  Restarting from a snapshot instead of re-inserting every entry
+    void BenchSnapshot() {
+        constexpr std::size_t snapshot_size{1 << 21};
+        auto const path = std::filesystem::temp_directory_path() / "bench_skiplist.skl";
+        auto const keys = RandomKeys(snapshot_size, Key{1} << 40, 6);
+
+        SkipListType source(max_level, SkipListLevelGenerator(.5, level_seed));
+        auto const insert_elapsed = ElapsedNs([&] {
+            for(auto key : keys) source.Insert(key, key);
+        });
+        Report("SkipList::Insert (random keys)", snapshot_size, insert_elapsed);
+
+        auto const save_elapsed = ElapsedNs([&] { SaveSkipList(source, path); });
+        Report("SaveSkipList", source.Size(), save_elapsed);
+        {
+            SkipListType restored(max_level, SkipListLevelGenerator(.5, level_seed));
+            auto const elapsed = ElapsedNs([&] { LoadSkipList(restored, path); });
+            Report("LoadSkipList", restored.Size(), elapsed);
+        }
+        {
+            SkipListFileView<Key, Value> view;
+            auto const open_elapsed = ElapsedNs([&] { view.Open(path); });
+            Report("SkipListFileView::Open", 1, open_elapsed);
+            auto const probes = RandomKeys(nbr_ops, snapshot_size, 7);
+            auto const elapsed = ElapsedNs([&] {
+                for(auto index : probes) DoNotOptimize(view.Find(view.Keys()[index]));
+            });
+            Report("SkipListFileView::Find", nbr_ops, elapsed);
+        }
+        std::filesystem::remove(path);
+    }
+
+    /// @brief  Applying a delta to a large base list
+    void BenchMerge() {
+        constexpr std::size_t delta_size{1 << 16};
+        auto const delta_keys = RandomKeys(delta_size, 4 * list_size, 8);
+        auto build_base = [] {
+            SkipListType base(max_level, SkipListLevelGenerator(.5, level_seed));
+            base.BulkLoad(std::views::transform(std::views::iota(Key{}, Key{4 * list_size / 2}),
+                [](Key key) { return std::pair<Key, Value>(2 * key, key); }));
+            return base;
+        };
+        auto build_delta = [&delta_keys] {
+            SkipListType delta(max_level, SkipListLevelGenerator(.5, level_seed + 1));
+            for(auto key : delta_keys) delta.Insert(key, key);
+            return delta;
+        };
+        {
+            auto base = build_base();
+            auto delta = build_delta();
+            auto const elapsed = ElapsedNs([&] {
+                for(auto const& node : delta) base.Insert(node.Key(), node.Value());
+            });
+            Report("SkipList::Insert (each key of a delta)", delta.Size(), elapsed);
+        }
+        {
+            auto base = build_base();
+            auto delta = build_delta();
+            auto const size = delta.Size();
+            auto const elapsed = ElapsedNs([&] { base.Merge(delta); });
+            Report("SkipList::Merge (delta)", size, elapsed);
+        }
+        {
+            auto base = build_base();
+            auto const elapsed = ElapsedNs([&] { DoNotOptimize(base.Split(2 * list_size)); });
+            Report("SkipList::Split", 1, elapsed);
+        }
+    }
+
+    /// @brief  Writers inserting concurrently into one shard and into many
+    void BenchSharded() {
+        auto const threads = std::max(1u, std::thread::hardware_concurrency());
+        auto const keys = RandomKeys(nbr_ops, Key{1} << 40, 9);
+        for(std::size_t shards : {1, 8, 32}) {
+            using ShardedType = ShardedSkipList<Key, Value, SkipListHashRouter<Key>>;
+            ShardedType skip_list(SkipListHashRouter<Key>(shards), max_level,
+                [](std::size_t shard) { return SkipListFastLevelGenerator<>(level_seed + shard); });
+            auto const elapsed = ElapsedNs([&] {
+                std::vector<std::jthread> writers;
+                for(unsigned thread = 0; thread < threads; ++thread) {
+                    writers.emplace_back([&, thread] {
+                        for(auto index = thread; index < keys.size(); index += threads) {
+                            skip_list.InsertOrAssign(keys[index], index);
+                        }
+                    });
+                }
+            });
+            Report(std::format("ShardedSkipList::InsertOrAssign ({} threads, {} shards)", threads, shards),
+                keys.size(), elapsed);
+        }
+    }
+
+    /// @brief  Point lookups and full scans of a list of blocks against a
+    ///         list of single key nodes holding the same keys
+    void BenchBlocks() {
+        constexpr std::size_t size{1 << 22};
+        auto const inserts = RandomKeys(size, Key{1} << 40, 10);
+        auto const probes = RandomKeys(nbr_ops, size, 11);
+
+        auto bench = [&](std::string_view name, auto& skip_list) {
+            auto const insert_elapsed = ElapsedNs([&] {
+                for(auto key : inserts) skip_list.Insert(key, key);
+            });
+            Report(std::format("{}::Insert ({} keys)", name, size), size, insert_elapsed);
+            auto const find_elapsed = ElapsedNs([&] {
+                for(auto index : probes) DoNotOptimize(skip_list.Find(inserts[index]));
+            });
+            Report(std::format("{}::Find", name), nbr_ops, find_elapsed);
+            Value sum{};
+            auto const scan_elapsed = ElapsedNs([&] {
+                for(auto const& entry : skip_list) sum += entry.Value();
+            });
+            DoNotOptimize(sum);
+            Report(std::format("{} full scan", name), skip_list.Size(), scan_elapsed);
+        };
+        {
+            SkipListType skip_list(max_level, SkipListLevelGenerator(.5, level_seed));
+            bench("SkipList", skip_list);
+        }
+        {
+            BlockSkipList<Key, Value> skip_list(max_level, SkipListLevelGenerator(.5, level_seed));
+            bench("BlockSkipList", skip_list);
+        }
+    }
+
+    /// @brief  Searches of a list much larger than the last level cache,
+    ///         with and without prefetching
+    void BenchPrefetch() {
+        constexpr std::size_t size{1 << 23};
+        auto const probes = RandomKeys(nbr_ops, size, 12);
+        auto const sorted_probes = [&probes] {
+            auto sorted = probes;
+            std::ranges::sort(sorted);
+            return sorted;
+        }();
+
+        auto bench = [&](std::string_view name, auto& skip_list) {
+            skip_list.BulkLoad(std::views::transform(std::views::iota(Key{}, Key{size}),
+                [](Key key) { return std::pair<Key, Value>(key, key); }));
+            auto const find_elapsed = ElapsedNs([&] {
+                for(auto key : probes) DoNotOptimize(skip_list.Find(key));
+            });
+            Report(std::format("SkipList::Find ({}, 8M nodes)", name), nbr_ops, find_elapsed);
+            auto const interleaved_elapsed = ElapsedNs([&] { DoNotOptimize(skip_list.FindInterleaved(probes)); });
+            Report(std::format("SkipList::FindInterleaved ({}, 8M nodes)", name), nbr_ops, interleaved_elapsed);
+            auto const batch_elapsed = ElapsedNs([&] { DoNotOptimize(skip_list.FindBatch(sorted_probes)); });
+            Report(std::format("SkipList::FindBatch ({}, 8M nodes)", name), nbr_ops, batch_elapsed);
+        };
+        {
+            SkipListType skip_list(max_level, SkipListLevelGenerator(.5, level_seed));
+            bench("no prefetch", skip_list);
+        }
+        {
+            SkipList<Key, Value, std::less<Key>, Prefetching> skip_list(max_level, SkipListLevelGenerator(.5, level_seed));
+            bench("prefetch", skip_list);
+        }
+    }
+
+    /// @brief  Removing expired sessions with one sweep of the whole list
+    ///         against many bounded EvictExpired calls
+    void BenchExpiry() {
+        using ExpiringType = SkipList<Key, Value, std::less<Key>, SkipListExpiring>;
+        auto const keys = RandomKeys(list_size, Key{1} << 40, 13);
+        auto const now = std::chrono::steady_clock::now();
+        auto build = [&](ExpiringType& skip_list) {
+            for(std::size_t i = 0; i < keys.size(); ++i) {
+                //  every other session has expired
+                auto const expires = i % 2 != 0 ? now - std::chrono::seconds(1) : now + std::chrono::hours(1);
+                skip_list.InsertOrAssign(keys[i], i, expires);
+            }
+        };
+        {
+            ExpiringType skip_list(max_level, SkipListLevelGenerator(.5, level_seed));
+            build(skip_list);
+            std::vector<Key> expired;
+            auto const elapsed = ElapsedNs([&] {
+                for(auto const& node : skip_list) {
+                    if(skip_list.ExpiryOf(node.Key()) == std::nullopt) expired.push_back(node.Key());
+                }
+                for(auto key : expired) skip_list.Delete(key);
+            });
+            Report(std::format("SkipList full sweep ({} expired, one call)", expired.size()), expired.size(), elapsed);
+        }
+        {
+            constexpr std::size_t budget{1024};
+            ExpiringType skip_list(max_level, SkipListLevelGenerator(.5, level_seed));
+            build(skip_list);
+            std::size_t evicted{};
+            double longest{};
+            double total{};
+            for(;;) {
+                std::size_t removed{};
+                auto const elapsed = ElapsedNs([&] { removed = skip_list.EvictExpired(budget, now); });
+                if(removed == 0) break;
+                evicted += removed;
+                total += elapsed;
+                longest = std::max(longest, elapsed);
+            }
+            Report(std::format("SkipList::EvictExpired (budget {})", budget), evicted, total);
+            std::cout << std::format("{:<52} {:>10.1f} us\n", "  longest EvictExpired call", longest / 1000);
+        }
+    }
+}
+
+int main() {
+    BenchUpdate();
+    BenchChurn();
+    BenchWarmStart();
+    BenchBatches();
+    BenchLevelGenerators();
+    BenchLevelGrowth();
+    BenchSnapshot();
+    BenchMerge();
+    BenchSharded();
+    BenchBlocks();
+    BenchPrefetch();
+    BenchExpiry();
+    return 0;
+}
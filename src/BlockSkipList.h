@@ -0,0 +1,593 @@
+#pragma once
+/// @copyright {2024, Russell J. Fleming. All rights reserved.}
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// This code is based on:
+///     W. Pugh, "A Skip List Cookbook" (partitioned skip lists)
+///     https://en.wikipedia.org/wiki/Unrolled_linked_list
+#include    "SkipListNode.h"
+#include    "SkipListError.h"
+#include    "SkipListArena.h"
+
+#include    <algorithm>
+#include    <array>
+#include    <cstddef>
+#include    <cstdint>
+#include    <functional>
+#include    <iterator>
+#include    <memory>
+#include    <new>
+#include    <optional>
+#include    <type_traits>
+#include    <utility>
+
+namespace pentifica::tbox {
+    /// @brief  Default number of keys in a block: enough keys to fill two
+    ///         cache lines, and never fewer than 4
+    template<typename K>
+    inline constexpr std::size_t block_skip_list_block_size{std::max<std::size_t>(4, 128 / sizeof(K))};
+
+    /// @brief  A key-value pair in a BlockSkipList, as seen through an
+    ///         iterator. It refers to the pair stored in its block.
+    /// @tparam K   The key type
+    /// @tparam V   The value type, const for a const iterator
+    template<typename K, typename V>
+    class BlockSkipListEntry {
+    public:
+        BlockSkipListEntry() noexcept = default;
+        BlockSkipListEntry(K const* key, V* value) noexcept
+            : key_(key)
+            , value_(value)
+        {}
+        /// @brief  The key is returned
+        K const& Key() const noexcept { return *key_; }
+        /// @brief  The value is returned
+        V& Value() const noexcept { return *value_; }
+
+    private:
+        K const* key_{};
+        V* value_{};
+    };
+
+    /// @brief  Defines an iterator that does a forward traversal of the
+    ///         key-value pairs of a BlockSkipList, block by block. It
+    ///         dereferences to a BlockSkipListEntry by value.
+    /// @tparam BL  The BlockSkipList type to iterate over
+    template<typename BL>
+    class BlockSkipListIterator {
+        using block_type = typename BL::block_type;
+        static constexpr bool is_const{std::is_const_v<BL>};
+        using mapped_type = std::conditional_t<is_const, typename BL::mapped_type const, typename BL::mapped_type>;
+
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+
+        using value_type = BlockSkipListEntry<typename BL::key_type, mapped_type>;
+        using difference_type = std::ptrdiff_t;
+        using reference = value_type;
+
+        /// @brief  Gives operator-> a stable address for the entry
+        struct pointer {
+            value_type entry_;
+            value_type const* operator->() const noexcept { return &entry_; }
+        };
+
+        /// @brief  Prepare an instance referring to no list
+        BlockSkipListIterator() noexcept = default;
+        /// @brief  Prepare an instance
+        /// @param  block   The block holding the pair, nullptr at the end
+        /// @param  index   The position of the pair in its block
+        BlockSkipListIterator(block_type* block, std::uint32_t index) noexcept
+            : block_(block)
+            , index_(index)
+        {}
+        BlockSkipListIterator(BlockSkipListIterator const& other) noexcept = default;
+        BlockSkipListIterator& operator=(BlockSkipListIterator const& other) noexcept = default;
+        /// @brief  Prepare a const iterator from an iterator of the same list
+        /// @param  other   The iterator to convert
+        BlockSkipListIterator(BlockSkipListIterator<std::remove_const_t<BL>> const& other) noexcept requires is_const
+            : block_(other.block_)
+            , index_(other.index_)
+        {}
+        /// @brief  Pre-increment advance
+        /// @return The advanced iterator
+        BlockSkipListIterator& operator++() noexcept {
+            if(++index_ == block_->count_) {
+                block_ = block_->Link(0);
+                index_ = 0;
+            }
+            return *this;
+        }
+        /// @brief  Post-increment advance
+        BlockSkipListIterator operator++(int) noexcept {
+            auto temp{*this};
+            ++(*this);
+            return temp;
+        }
+        friend bool operator==(BlockSkipListIterator const& lhs, BlockSkipListIterator const& rhs) noexcept {
+            return lhs.block_ == rhs.block_ && lhs.index_ == rhs.index_;
+        }
+        reference operator*() const noexcept {
+            return {&block_->keys_[index_], &block_->values_[index_]};
+        }
+        pointer operator->() const noexcept { return {**this}; }
+
+    private:
+        template<typename>
+        friend class BlockSkipListIterator;
+
+        block_type* block_{};
+        std::uint32_t index_{};
+    };
+
+    /// @brief  A skip list whose nodes are blocks of up to B sorted keys
+    ///         (an unrolled skip list). The towers index the first key of
+    ///         every block, so the index is B times smaller, and a scan reads
+    ///         B keys from each block instead of taking a cache miss per key.
+    ///         Keys and values are stored in separate arrays, so the search
+    ///         within a block runs over contiguous keys: it counts the keys
+    ///         ordered before the probe without branching, a loop compilers
+    ///         vectorize for arithmetic keys.
+    ///
+    ///         A full block splits in two. A block that drops to half full
+    ///         or less takes in the pairs of its successor when they fit, and
+    ///         otherwise borrows enough of them to be half full again, so
+    ///         every block but the last stays at least half full.
+    /// @note   Inserting or deleting moves pairs within a block, so an
+    ///         iterator or Lookup pointer is invalidated by any change to
+    ///         the list. For the same reason keys must be copy assignable
+    ///         and values move assignable.
+    /// @tparam K   The key type
+    /// @tparam V   The value type
+    /// @tparam Compare Orders the keys
+    /// @tparam B   The number of keys in a block
+    /// @tparam LevelGen    Generates the level of a new block
+    template<typename K, typename V,
+        typename Compare = std::less<K>,
+        std::size_t B = block_skip_list_block_size<K>,
+        typename LevelGen = std::function<int(int)>>
+    requires SkipNodeArgs<K, V> && std::is_copy_assignable_v<K> && std::is_move_assignable_v<V> && (B >= 2)
+    class BlockSkipList {
+        /// @brief  A node of the list. Its links are stored directly after it,
+        ///         in the same block of arena storage.
+        struct Block {
+            Block(int level) noexcept
+                : level_(level)
+            {
+                std::uninitialized_value_construct_n(LinksData(), level + 1);
+            }
+            /// @brief  Returns the number of bytes needed for a block and its links
+            static constexpr std::size_t AllocationSize(int level) noexcept {
+                return LinksOffset() + (level + 1) * sizeof(Block*);
+            }
+            static constexpr std::size_t LinksOffset() noexcept {
+                return (sizeof(Block) + alignof(Block*) - 1) / alignof(Block*) * alignof(Block*);
+            }
+            Block** LinksData() const noexcept {
+                return std::launder(reinterpret_cast<Block**>(
+                    reinterpret_cast<std::byte*>(const_cast<Block*>(this)) + LinksOffset()));
+            }
+            /// @brief  Returns the link to the next block at a level
+            Block*& Link(int level) const noexcept { return LinksData()[level]; }
+            /// @brief  The key the towers index the block by
+            K const& First() const noexcept { return keys_[0]; }
+
+            int const level_{};
+            std::uint32_t count_{};
+            std::array<K, B> keys_{};
+            std::array<V, B> values_{};
+        };
+        using update_type = std::array<Block*, skip_list_level_limit>;
+
+    public:
+        using key_type = K;
+        using mapped_type = V;
+        using key_compare = Compare;
+        using level_generator_type = LevelGen;
+        using block_type = Block;
+        using iterator = BlockSkipListIterator<BlockSkipList>;
+        using const_iterator = BlockSkipListIterator<BlockSkipList const>;
+        friend iterator;
+        friend const_iterator;
+
+        /// @brief  The number of keys in a block
+        static constexpr std::size_t block_size{B};
+
+        /// @brief  Basic setup of an instance
+        /// @param  max_level   Initial number of levels. The number of levels
+        ///                     grows with the number of blocks, as in SkipList.
+        /// @param  gen_next_skip_level  Generates a skip level (0 .. max_level - 1)
+        /// @param  compare     Orders the keys
+        BlockSkipList(int max_level, LevelGen gen_next_skip_level, Compare compare = Compare{});
+        BlockSkipList(BlockSkipList const&) = delete;
+        BlockSkipList& operator=(BlockSkipList const&) = delete;
+        /// @brief  Instance cleanup
+        ~BlockSkipList();
+
+        /// @brief  Get the value associated with a particular key
+        /// @param  key     The lookup key
+        /// @return An optional value referencing the value associated with the key
+        std::optional<V> Find(K const& key) const {
+            auto value = Lookup(key);
+            return value != nullptr ? std::optional<V>(*value) : std::nullopt;
+        }
+        /// @brief  Get the value associated with a particular key without copying it
+        /// @param  key     The lookup key
+        /// @return The address of the value, nullptr if the key is not found.
+        ///         It remains valid until the list is changed.
+        V* Lookup(K const& key) {
+            return const_cast<V*>(std::as_const(*this).Lookup(key));
+        }
+        V const* Lookup(K const& key) const;
+
+        /// @brief  Insert a key-value pair, replacing the value of an existing key
+        /// @param key
+        /// @param value
+        /// @return
+        V
+        Insert(K const& key, V const& value) {
+            InsertOrAssign(key, value);
+            return value;
+        }
+        /// @brief  Insert a key-value pair, or assign the value to an existing key
+        /// @param  key
+        /// @param  value
+        /// @return True if the key was inserted
+        bool InsertOrAssign(K const& key, V value);
+
+        /// @brief Delete a key-value pair from the list
+        /// @param key The key to delete
+        /// @return
+        SkipListError::ErrorVariant
+        Delete(K const& key);
+
+        /// @brief  Returns an iterator to the first pair whose key is not less than key
+        iterator LowerBound(K const& key) {
+            auto [block, index] = Seek(key);
+            return iterator(block, index);
+        }
+        const_iterator LowerBound(K const& key) const {
+            auto [block, index] = Seek(key);
+            return const_iterator(block, index);
+        }
+
+        /// @brief  Visit, in key order, every pair with a key in [first, last)
+        /// @param  first   The first key of the range
+        /// @param  last    The key ending the range (not visited)
+        /// @param  visitor Invoked with each entry. If it returns a bool, the
+        ///                 scan stops when it returns false.
+        /// @return The number of pairs visited
+        template<typename Visitor>
+        std::size_t ForEachInRange(K const& first, K const& last, Visitor&& visitor);
+
+        /// @brief  Returns the number of key-value pairs
+        auto Size() const noexcept { return count_; }
+        /// @brief  Returns true if there are no key-value pairs
+        bool Empty() const noexcept { return count_ == 0; }
+        /// @brief  Returns the number of blocks holding the pairs
+        auto Blocks() const noexcept { return blocks_; }
+        /// @brief  Returns the number of levels holding at least one block
+        auto Levels() const noexcept { return top_level_; }
+
+        iterator begin() { return iterator(head_[0], 0); }
+        iterator end() { return iterator(); }
+        const_iterator begin() const { return const_iterator(head_[0], 0); }
+        const_iterator end() const { return const_iterator(); }
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend() const { return end(); }
+
+    private:
+        bool Less(K const& lhs, K const& rhs) const { return compare_(lhs, rhs); }
+        /// @brief  Returns the link following a block at a level, the list
+        ///         head when block is nullptr
+        Block*& Next(Block* block, int level) const noexcept {
+            return block != nullptr ? block->Link(level) : head_[level];
+        }
+        /// @brief  Find the last block whose first key is not after key
+        /// @param  key     The key to locate
+        /// @param  update  Set to the last such block at every level; nullptr
+        ///                 for the head
+        /// @return The block, nullptr if key orders before every block
+        Block* FindBlock(K const& key, update_type* update = nullptr) const;
+        /// @brief  Find the blocks linking to the block whose first key is first
+        update_type IdentifyPredecessors(K const& first) const;
+        /// @brief  Returns the number of keys in a block ordered before key.
+        ///         Every key is compared, so the loop has no data dependent
+        ///         branch.
+        std::uint32_t LowerIndex(Block const* block, K const& key) const {
+            std::uint32_t index{};
+            for(std::uint32_t i = 0; i < block->count_; ++i) {
+                index += Less(block->keys_[i], key);
+            }
+            return index;
+        }
+        /// @brief  Returns the position of the first pair not less than key
+        std::pair<Block*, std::uint32_t> Seek(K const& key) const;
+        /// @brief  Returns true if a block holds key at index
+        bool Matches(Block const* block, std::uint32_t index, K const& key) const {
+            return index < block->count_ && !Less(key, block->keys_[index]);
+        }
+        Block* CreateBlock() {
+            while(max_level_ < skip_list_level_limit && blocks_ >= (std::size_t{1} << max_level_)) {
+                ++max_level_;
+            }
+            auto level = gen_next_skip_level_(max_level_);
+            auto storage = arena_.Allocate(Block::AllocationSize(level), level);
+            ++blocks_;
+            return ::new(storage) Block(level);
+        }
+        void DestroyBlock(Block* block) {
+            auto level = block->level_;
+            std::destroy_at(block);
+            arena_.Deallocate(block, level);
+            --blocks_;
+        }
+        /// @brief  Link a block after its predecessors
+        void LinkBlock(update_type const& update, Block* block) {
+            for(int i = 0; i <= block->level_; i++) {
+                block->Link(i) = Next(update[i], i);
+                Next(update[i], i) = block;
+            }
+            top_level_ = std::max(top_level_, block->level_ + 1);
+        }
+        /// @brief  Unlink and destroy a block
+        void UnlinkBlock(update_type const& update, Block* block) {
+            for(int i = 0; i <= block->level_; i++) {
+                Next(update[i], i) = block->Link(i);
+            }
+            DestroyBlock(block);
+        }
+        /// @brief  Move the pairs of a block from index on to the start of another
+        static void MoveTail(Block* from, std::uint32_t index, Block* to) {
+            std::move(from->keys_.begin() + index, from->keys_.begin() + from->count_, to->keys_.begin() + to->count_);
+            std::move(from->values_.begin() + index, from->values_.begin() + from->count_, to->values_.begin() + to->count_);
+            to->count_ += from->count_ - index;
+            from->count_ = index;
+        }
+        /// @brief  Move the first count pairs of a block to the end of another
+        static void MoveHead(Block* from, std::uint32_t count, Block* to) {
+            std::move(from->keys_.begin(), from->keys_.begin() + count, to->keys_.begin() + to->count_);
+            std::move(from->values_.begin(), from->values_.begin() + count, to->values_.begin() + to->count_);
+            std::move(from->keys_.begin() + count, from->keys_.begin() + from->count_, from->keys_.begin());
+            std::move(from->values_.begin() + count, from->values_.begin() + from->count_, from->values_.begin());
+            to->count_ += count;
+            from->count_ -= count;
+        }
+
+        SkipListArena arena_;
+        std::size_t count_{};
+        std::size_t blocks_{};
+        mutable update_type head_{};
+        int max_level_{};
+        int top_level_{1};
+        LevelGen gen_next_skip_level_;
+        [[no_unique_address]] Compare compare_;
+    };
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare, std::size_t B, typename LevelGen>
+    requires SkipNodeArgs<K, V> && std::is_copy_assignable_v<K> && std::is_move_assignable_v<V> && (B >= 2)
+    BlockSkipList<K, V, Compare, B, LevelGen>::BlockSkipList(int max_level, LevelGen gen_next_skip_level, Compare compare)
+        : max_level_(std::clamp(max_level, 1, skip_list_level_limit))
+        , gen_next_skip_level_(std::move(gen_next_skip_level))
+        , compare_(std::move(compare))
+    {
+        static_assert(alignof(Block) <= SkipListArena::block_alignment);
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare, std::size_t B, typename LevelGen>
+    requires SkipNodeArgs<K, V> && std::is_copy_assignable_v<K> && std::is_move_assignable_v<V> && (B >= 2)
+    BlockSkipList<K, V, Compare, B, LevelGen>::~BlockSkipList() {
+        for(auto block = head_[0]; block != nullptr;) {
+            auto next = block->Link(0);
+            std::destroy_at(block);
+            block = next;
+        }
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare, std::size_t B, typename LevelGen>
+    requires SkipNodeArgs<K, V> && std::is_copy_assignable_v<K> && std::is_move_assignable_v<V> && (B >= 2)
+    typename BlockSkipList<K, V, Compare, B, LevelGen>::Block*
+    BlockSkipList<K, V, Compare, B, LevelGen>::FindBlock(K const& key, update_type* update) const {
+        Block* current{};
+
+        for(auto current_level = top_level_ - 1; current_level >= 0; current_level--) {
+            for(auto next = Next(current, current_level);
+                next != nullptr && !Less(key, next->First());
+                next = next->Link(current_level)) {
+                current = next;
+            }
+            if(update != nullptr) {
+                (*update)[current_level] = current;
+            }
+        }
+
+        return current;
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare, std::size_t B, typename LevelGen>
+    requires SkipNodeArgs<K, V> && std::is_copy_assignable_v<K> && std::is_move_assignable_v<V> && (B >= 2)
+    typename BlockSkipList<K, V, Compare, B, LevelGen>::update_type
+    BlockSkipList<K, V, Compare, B, LevelGen>::IdentifyPredecessors(K const& first) const {
+        update_type update{};
+        Block* current{};
+
+        for(auto current_level = top_level_ - 1; current_level >= 0; current_level--) {
+            for(auto next = Next(current, current_level);
+                next != nullptr && Less(next->First(), first);
+                next = next->Link(current_level)) {
+                current = next;
+            }
+            update[current_level] = current;
+        }
+
+        return update;
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare, std::size_t B, typename LevelGen>
+    requires SkipNodeArgs<K, V> && std::is_copy_assignable_v<K> && std::is_move_assignable_v<V> && (B >= 2)
+    std::pair<typename BlockSkipList<K, V, Compare, B, LevelGen>::Block*, std::uint32_t>
+    BlockSkipList<K, V, Compare, B, LevelGen>::Seek(K const& key) const {
+        auto block = FindBlock(key);
+        if(block == nullptr) {
+            return {head_[0], 0};
+        }
+        auto index = LowerIndex(block, key);
+        if(index == block->count_) {
+            return {block->Link(0), 0};
+        }
+        return {block, index};
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare, std::size_t B, typename LevelGen>
+    requires SkipNodeArgs<K, V> && std::is_copy_assignable_v<K> && std::is_move_assignable_v<V> && (B >= 2)
+    V const*
+    BlockSkipList<K, V, Compare, B, LevelGen>::Lookup(K const& key) const {
+        auto block = FindBlock(key);
+        if(block == nullptr) {
+            return nullptr;
+        }
+        auto index = LowerIndex(block, key);
+        return Matches(block, index, key) ? &block->values_[index] : nullptr;
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare, std::size_t B, typename LevelGen>
+    requires SkipNodeArgs<K, V> && std::is_copy_assignable_v<K> && std::is_move_assignable_v<V> && (B >= 2)
+    bool
+    BlockSkipList<K, V, Compare, B, LevelGen>::InsertOrAssign(K const& key, V value) {
+        update_type update{};
+        auto block = FindBlock(key, &update);
+
+        //  a key ordered before every block goes to the front of the first block
+        if(block == nullptr) {
+            block = head_[0];
+            if(block == nullptr) {
+                block = CreateBlock();
+                LinkBlock(update, block);
+            }
+        }
+
+        auto index = LowerIndex(block, key);
+        if(Matches(block, index, key)) {
+            block->values_[index] = std::move(value);
+            return false;
+        }
+
+        //  split a full block, moving its upper half to a new block linked
+        //  after it
+        if(block->count_ == B) {
+            for(int i = 0; i <= block->level_; i++) {
+                update[i] = block;
+            }
+            auto upper = CreateBlock();
+            MoveTail(block, B / 2, upper);
+            LinkBlock(update, upper);
+            if(index > B / 2) {
+                block = upper;
+                index -= B / 2;
+            }
+        }
+
+        std::move_backward(block->keys_.begin() + index, block->keys_.begin() + block->count_,
+            block->keys_.begin() + block->count_ + 1);
+        std::move_backward(block->values_.begin() + index, block->values_.begin() + block->count_,
+            block->values_.begin() + block->count_ + 1);
+        block->keys_[index] = key;
+        block->values_[index] = std::move(value);
+        ++block->count_;
+        ++count_;
+        return true;
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare, std::size_t B, typename LevelGen>
+    requires SkipNodeArgs<K, V> && std::is_copy_assignable_v<K> && std::is_move_assignable_v<V> && (B >= 2)
+    SkipListError::ErrorVariant
+    BlockSkipList<K, V, Compare, B, LevelGen>::Delete(K const& key) {
+        auto block = FindBlock(key);
+        auto index = block != nullptr ? LowerIndex(block, key) : 0;
+        if(block == nullptr || !Matches(block, index, key)) {
+            return SkipListError::ErrorVariant::KEY_NOT_FOUND;
+        }
+
+        //  the last pair of a block takes the block with it
+        if(block->count_ == 1) {
+            UnlinkBlock(IdentifyPredecessors(key), block);
+            --count_;
+            return SkipListError::ErrorVariant::NOERR;
+        }
+
+        std::move(block->keys_.begin() + index + 1, block->keys_.begin() + block->count_, block->keys_.begin() + index);
+        std::move(block->values_.begin() + index + 1, block->values_.begin() + block->count_, block->values_.begin() + index);
+        --block->count_;
+        --count_;
+
+        //  a block at most half full takes in its successor when they fit;
+        //  one below half full otherwise evens out the pairs of the two. The
+        //  successor keeps its place: its first key only moves up.
+        if(auto next = block->Link(0); next != nullptr && block->count_ <= B / 2) {
+            if(block->count_ + next->count_ <= B) {
+                auto update = IdentifyPredecessors(next->First());
+                MoveTail(next, 0, block);
+                UnlinkBlock(update, next);
+            }
+            else if(block->count_ < B / 2) {
+                MoveHead(next, (next->count_ - block->count_) / 2, block);
+            }
+        }
+
+        return SkipListError::ErrorVariant::NOERR;
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare, std::size_t B, typename LevelGen>
+    requires SkipNodeArgs<K, V> && std::is_copy_assignable_v<K> && std::is_move_assignable_v<V> && (B >= 2)
+    template<typename Visitor>
+    std::size_t
+    BlockSkipList<K, V, Compare, B, LevelGen>::ForEachInRange(K const& first, K const& last, Visitor&& visitor) {
+        std::size_t visited{};
+        using entry_type = typename iterator::value_type;
+
+        for(auto [block, index] = Seek(first); block != nullptr; block = block->Link(0), index = 0) {
+            for(; index < block->count_; ++index) {
+                if(!Less(block->keys_[index], last)) {
+                    return visited;
+                }
+                ++visited;
+                auto entry = entry_type(&block->keys_[index], &block->values_[index]);
+                if constexpr(std::is_convertible_v<std::invoke_result_t<Visitor&, entry_type const&>, bool>) {
+                    if(!std::invoke(visitor, entry)) return visited;
+                }
+                else {
+                    std::invoke(visitor, entry);
+                }
+            }
+        }
+
+        return visited;
+    }
+}
@@ -0,0 +1,479 @@
+#pragma once
+/// @copyright {2024, Russell J. Fleming. All rights reserved.}
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// This code is based on:
+///     M. Herlihy, N. Shavit, "The Art of Multiprocessor Programming", ch. 14.4
+///     K. Fraser, "Practical lock-freedom", UCAM-CL-TR-579 (epoch based reclamation)
+#include    "SkipListNode.h"
+#include    "SkipListError.h"
+
+#include    <array>
+#include    <atomic>
+#include    <cstdint>
+#include    <functional>
+#include    <optional>
+#include    <thread>
+#include    <vector>
+
+namespace pentifica::tbox {
+    namespace internal {
+        /// @brief  Epoch based memory reclamation. Threads pin the current
+        ///         epoch for the duration of an operation; retired objects are
+        ///         released once every pinned thread has moved two epochs past
+        ///         the epoch the object was retired in.
+        class EpochDomain {
+        public:
+            /// @brief  Maximum number of operations that can be pinned at once
+            static constexpr std::size_t slot_count{128};
+            /// @brief  Number of retirements between reclamation attempts
+            static constexpr std::size_t collect_threshold{64};
+
+            /// @brief  Keeps an epoch slot claimed while in scope
+            class Guard {
+            public:
+                explicit Guard(EpochDomain& domain) noexcept
+                    : slot_(domain.Claim())
+                {}
+                Guard(Guard const&) = delete;
+                Guard& operator=(Guard const&) = delete;
+                ~Guard() { slot_->store(0, std::memory_order_release); }
+
+            private:
+                std::atomic<std::uint64_t>* slot_{};
+            };
+
+            EpochDomain() = default;
+            EpochDomain(EpochDomain const&) = delete;
+            EpochDomain& operator=(EpochDomain const&) = delete;
+            /// @brief  Release everything still waiting on a grace period.
+            ///         No thread may be pinned when the domain is destroyed.
+            ~EpochDomain() {
+                for(auto item = retired_.exchange(nullptr); item != nullptr;) {
+                    auto next = item->next_;
+                    item->deleter_(item->object_);
+                    delete item;
+                    item = next;
+                }
+            }
+            /// @brief  Pins the current epoch for the calling thread
+            /// @return The guard releasing the pin
+            Guard Pin() noexcept { return Guard(*this); }
+            /// @brief  Hand off an unlinked object for deferred release
+            /// @param  object  The object to release
+            /// @param  deleter Releases the object
+            void Retire(void* object, void(*deleter)(void*)) {
+                auto item = new Retired{
+                    nullptr, object, deleter,
+                    global_epoch_.load(std::memory_order_seq_cst)};
+                Push(item, item);
+                if(retired_count_.fetch_add(1, std::memory_order_relaxed) % collect_threshold
+                    == collect_threshold - 1) {
+                    Collect();
+                }
+            }
+            /// @brief  Attempt to advance the epoch and release the objects
+            ///         whose grace period has expired
+            void Collect() {
+                if(collecting_.test_and_set(std::memory_order_acquire)) return;
+
+                auto epoch = global_epoch_.load(std::memory_order_seq_cst);
+                bool quiescent{true};
+                for(auto const& slot : slots_) {
+                    auto pinned = slot.epoch_.load(std::memory_order_seq_cst);
+                    if(pinned != 0 && pinned != epoch) {
+                        quiescent = false;
+                        break;
+                    }
+                }
+                if(quiescent) {
+                    global_epoch_.compare_exchange_strong(epoch, epoch + 1,
+                        std::memory_order_seq_cst);
+                }
+
+                auto const safe = global_epoch_.load(std::memory_order_seq_cst);
+                Retired* keep_head{};
+                Retired* keep_tail{};
+                for(auto item = retired_.exchange(nullptr, std::memory_order_acquire); item != nullptr;) {
+                    auto next = item->next_;
+                    if(item->epoch_ + 2 <= safe) {
+                        item->deleter_(item->object_);
+                        delete item;
+                        retired_count_.fetch_sub(1, std::memory_order_relaxed);
+                    }
+                    else {
+                        item->next_ = keep_head;
+                        keep_head = item;
+                        if(keep_tail == nullptr) keep_tail = item;
+                    }
+                    item = next;
+                }
+                if(keep_head != nullptr) {
+                    Push(keep_head, keep_tail);
+                }
+
+                collecting_.clear(std::memory_order_release);
+            }
+
+        private:
+            /// @brief  Deferred release record
+            struct Retired {
+                Retired* next_{};
+                void* object_{};
+                void(*deleter_)(void*){};
+                std::uint64_t epoch_{};
+            };
+            /// @brief  A pin slot, padded to avoid false sharing
+            struct alignas(64) Slot {
+                std::atomic<std::uint64_t> epoch_{};
+            };
+            /// @brief  Claim a free slot and publish the current epoch in it
+            /// @return The claimed slot
+            std::atomic<std::uint64_t>* Claim() noexcept {
+                thread_local std::size_t hint{
+                    std::hash<std::thread::id>{}(std::this_thread::get_id())};
+                for(;; std::this_thread::yield()) {
+                    for(std::size_t i = 0; i < slot_count; ++i) {
+                        auto& slot = slots_[(hint + i) % slot_count].epoch_;
+                        std::uint64_t expected{};
+                        auto epoch = global_epoch_.load(std::memory_order_seq_cst);
+                        if(slot.load(std::memory_order_relaxed) == 0
+                            && slot.compare_exchange_strong(expected, epoch,
+                                std::memory_order_seq_cst)) {
+                            hint += i;
+                            return &slot;
+                        }
+                    }
+                }
+            }
+            /// @brief  Push a chain of records onto the retired stack
+            void Push(Retired* head, Retired* tail) noexcept {
+                auto top = retired_.load(std::memory_order_relaxed);
+                do {
+                    tail->next_ = top;
+                } while(!retired_.compare_exchange_weak(top, head,
+                    std::memory_order_release, std::memory_order_relaxed));
+            }
+
+            std::atomic<std::uint64_t> global_epoch_{1};
+            std::array<Slot, slot_count> slots_{};
+            std::atomic<Retired*> retired_{};
+            std::atomic<std::size_t> retired_count_{};
+            std::atomic_flag collecting_{};
+        };
+    }
+
+    /// @brief  Defines a lock-free skip list supporting any number of
+    ///         concurrent readers and writers. Links are updated with CAS,
+    ///         deletion marks a node's links before unlinking it, and unlinked
+    ///         nodes are reclaimed once no operation can still reference them.
+    /// @note   Lookups never block. A Delete racing the Insert of the same key
+    ///         waits for the insert to finish linking the node's tower.
+    /// @tparam K   The key type
+    /// @tparam V   The value type
+    template<typename K, typename V>
+    requires SkipNodeArgs<K, V>
+    class ConcurrentSkipList {
+    public:
+        /// @brief  Basic setup of an instance
+        /// @param  max_level   Number of levels in the skiplist
+        /// @param  gen_next_skip_level  Generates a skip level (0 .. max_level - 1).
+        ///                     It is invoked concurrently by writers and so must be
+        ///                     thread safe.
+        ConcurrentSkipList(int max_level, std::function<int(int)> gen_next_skip_level);
+        ConcurrentSkipList(ConcurrentSkipList const&) = delete;
+        ConcurrentSkipList& operator=(ConcurrentSkipList const&) = delete;
+        /// @brief  Instance cleanup. No operation may be in flight.
+        ~ConcurrentSkipList();
+
+        /// @brief  Get the value associated with a particular key
+        /// @param  key     The lookup key
+        /// @return A copy of the value associated with the key
+        std::optional<V>
+        Find(K const& key);
+
+        /// @brief  Insert a key-value pair, replacing the value of an existing key
+        /// @param key
+        /// @param value
+        /// @return The inserted value
+        V
+        Insert(K const& key, V const& value);
+
+        /// @brief Delete a key-value pair from the list
+        /// @param key The key to delete
+        /// @return
+        SkipListError::ErrorVariant
+        Delete(K const& key);
+
+        /// @brief Returns true if the list is empty.
+        /// @return
+        bool Empty() const { return Size() == 0; }
+
+        /// @brief  Returns the number of key/value pairs in the list
+        /// @return
+        auto Size() const { return count_.load(std::memory_order_relaxed); }
+
+    private:
+        /// @brief  Node with a markable tower. The low bit of a link marks the
+        ///         owning node as logically deleted at that level.
+        struct Node {
+            Node(int top_level, K key, V* value)
+                : key_(std::move(key))
+                , value_(value)
+                , top_level_(top_level)
+                , links_(top_level + 1)
+            {}
+            ~Node() { delete value_.load(std::memory_order_relaxed); }
+
+            K const key_{};
+            std::atomic<V*> value_{};
+            int const top_level_{};
+            std::atomic<bool> fully_linked_{};
+            std::vector<std::atomic<std::uintptr_t>> links_;
+        };
+
+        static std::uintptr_t Pack(Node* node, bool marked = false) noexcept {
+            return reinterpret_cast<std::uintptr_t>(node) | (marked ? 1 : 0);
+        }
+        static Node* Ptr(std::uintptr_t link) noexcept {
+            return reinterpret_cast<Node*>(link & ~std::uintptr_t{1});
+        }
+        static bool Marked(std::uintptr_t link) noexcept { return (link & 1) != 0; }
+
+        static void DeleteNode(void* node) { delete static_cast<Node*>(node); }
+        static void DeleteValue(void* value) { delete static_cast<V*>(value); }
+
+        /// @brief  Locate the predecessors and successors of key at every
+        ///         level, unlinking marked nodes found along the way
+        /// @return True if a node with the key is linked at level 0
+        bool Locate(K const& key, std::vector<Node*>& preds, std::vector<Node*>& succs);
+
+        std::atomic<std::size_t> count_{};
+        Node* begin_sentinel_{};
+        Node* end_sentinel_{};
+        const int max_level_{};
+        std::function<int(int)> gen_next_skip_level_{};
+        internal::EpochDomain epoch_{};
+    };
+
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V>
+    requires SkipNodeArgs<K, V>
+    ConcurrentSkipList<K, V>::ConcurrentSkipList(int max_level, std::function<int(int)> gen_next_skip_level)
+        : max_level_(max_level)
+        , gen_next_skip_level_(gen_next_skip_level)
+    {
+        begin_sentinel_ = new Node(max_level_ - 1, {}, nullptr);
+        end_sentinel_ = new Node(max_level_ - 1, {}, nullptr);
+
+        //  connect start and end nodes
+        for(auto& link : begin_sentinel_->links_) {
+            link.store(Pack(end_sentinel_), std::memory_order_relaxed);
+        }
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V>
+    requires SkipNodeArgs<K, V>
+    ConcurrentSkipList<K, V>::~ConcurrentSkipList() {
+        //  nodes still linked at level 0 are owned by the list; unlinked nodes
+        //  are owned by the epoch domain
+        for(auto node = Ptr(begin_sentinel_->links_[0].load(std::memory_order_acquire));
+            node != end_sentinel_;) {
+            auto next = Ptr(node->links_[0].load(std::memory_order_relaxed));
+            delete node;
+            node = next;
+        }
+
+        delete begin_sentinel_;
+        delete end_sentinel_;
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V>
+    requires SkipNodeArgs<K, V>
+    bool
+    ConcurrentSkipList<K, V>::Locate(K const& key, std::vector<Node*>& preds, std::vector<Node*>& succs) {
+    retry:
+        auto pred{begin_sentinel_};
+        Node* current{};
+
+        for(auto current_level = max_level_ - 1; current_level >= 0; current_level--) {
+            current = Ptr(pred->links_[current_level].load(std::memory_order_acquire));
+
+            for(;;) {
+                auto next = current->links_[current_level].load(std::memory_order_acquire);
+
+                //  unlink nodes marked as deleted at this level
+                while(Marked(next)) {
+                    auto expected = Pack(current);
+                    if(!pred->links_[current_level].compare_exchange_strong(expected, Pack(Ptr(next)),
+                        std::memory_order_acq_rel, std::memory_order_acquire)) {
+                        goto retry;
+                    }
+                    current = Ptr(next);
+                    next = current->links_[current_level].load(std::memory_order_acquire);
+                }
+
+                if(current != end_sentinel_ && current->key_ < key) {
+                    pred = current;
+                    current = Ptr(next);
+                }
+                else {
+                    break;
+                }
+            }
+
+            preds[current_level] = pred;
+            succs[current_level] = current;
+        }
+
+        return current != end_sentinel_ && current->key_ == key;
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V>
+    requires SkipNodeArgs<K, V>
+    V
+    ConcurrentSkipList<K, V>::Insert(K const& key, V const& value) {
+        auto guard = epoch_.Pin();
+        auto preds = std::vector<Node*>(max_level_, nullptr);
+        auto succs = std::vector<Node*>(max_level_, nullptr);
+        Node* new_node{};
+
+        for(;;) {
+            //  if the key exists, publish the new value and retire the old one
+            if(Locate(key, preds, succs)) {
+                auto old_value = succs[0]->value_.exchange(new V(value), std::memory_order_acq_rel);
+                epoch_.Retire(old_value, &DeleteValue);
+                delete new_node;
+                return value;
+            }
+
+            if(new_node == nullptr) {
+                auto level = gen_next_skip_level_(max_level_);
+                new_node = new Node(level, key, new V(value));
+            }
+
+            //  linking at level 0 makes the node part of the list
+            for(int i = 0; i <= new_node->top_level_; i++) {
+                new_node->links_[i].store(Pack(succs[i]), std::memory_order_relaxed);
+            }
+            auto expected = Pack(succs[0]);
+            if(preds[0]->links_[0].compare_exchange_strong(expected, Pack(new_node),
+                std::memory_order_release, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        count_.fetch_add(1, std::memory_order_relaxed);
+
+        //  link the rest of the tower, refreshing the splice points on contention
+        for(int i = 1; i <= new_node->top_level_; i++) {
+            for(;;) {
+                new_node->links_[i].store(Pack(succs[i]), std::memory_order_relaxed);
+                auto expected = Pack(succs[i]);
+                if(preds[i]->links_[i].compare_exchange_strong(expected, Pack(new_node),
+                    std::memory_order_release, std::memory_order_relaxed)) {
+                    break;
+                }
+                Locate(key, preds, succs);
+            }
+        }
+        new_node->fully_linked_.store(true, std::memory_order_release);
+
+        return value;
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V>
+    requires SkipNodeArgs<K, V>
+    std::optional<V>
+    ConcurrentSkipList<K, V>::Find(K const& key) {
+        auto guard = epoch_.Pin();
+        auto current{begin_sentinel_};
+        Node* next{};
+
+        for(auto search_level = max_level_ - 1; search_level >= 0; search_level--) {
+            next = Ptr(current->links_[search_level].load(std::memory_order_acquire));
+            for(;;) {
+                //  step over nodes that are marked as deleted
+                auto link = next->links_[search_level].load(std::memory_order_acquire);
+                while(next != end_sentinel_ && Marked(link)) {
+                    next = Ptr(link);
+                    link = next->links_[search_level].load(std::memory_order_acquire);
+                }
+                if(next == end_sentinel_ || !(next->key_ < key)) {
+                    break;
+                }
+                current = next;
+                next = Ptr(link);
+            }
+        }
+
+        if(next != end_sentinel_ && next->key_ == key) {
+            return *next->value_.load(std::memory_order_acquire);
+        }
+        else {
+            return std::nullopt;
+        }
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V>
+    requires SkipNodeArgs<K, V>
+    SkipListError::ErrorVariant
+    ConcurrentSkipList<K, V>::Delete(K const& key) {
+        auto guard = epoch_.Pin();
+        auto preds = std::vector<Node*>(max_level_, nullptr);
+        auto succs = std::vector<Node*>(max_level_, nullptr);
+
+        if(!Locate(key, preds, succs)) {
+            return SkipListError::ErrorVariant::KEY_NOT_FOUND;
+        }
+
+        auto node = succs[0];
+        while(!node->fully_linked_.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+
+        //  mark the upper levels, then level 0 which decides the owner
+        for(int i = node->top_level_; i > 0; i--) {
+            node->links_[i].fetch_or(1, std::memory_order_acq_rel);
+        }
+        auto link = node->links_[0].load(std::memory_order_acquire);
+        for(;;) {
+            if(Marked(link)) {
+                return SkipListError::ErrorVariant::KEY_NOT_FOUND;
+            }
+            if(node->links_[0].compare_exchange_weak(link, link | 1,
+                std::memory_order_acq_rel, std::memory_order_acquire)) {
+                break;
+            }
+        }
+
+        //  physically unlink the node at every level before retiring it
+        Locate(key, preds, succs);
+        count_.fetch_sub(1, std::memory_order_relaxed);
+        epoch_.Retire(node, &DeleteNode);
+
+        return SkipListError::ErrorVariant::NOERR;
+    }
+}
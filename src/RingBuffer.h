@@ -22,6 +22,7 @@
 //  HEADER FILES
 //======================================================================
 #include    <atomic>
+#include    <cstddef>
 #include    <memory>
 #include    <optional>
 #include    <mutex>
@@ -97,7 +98,10 @@ namespace pentifica::tbox {
         /// @return True if the instance added.
         bool TryPush(T const& obj) {
             if(!push_mutex_.try_lock()) return false;
-            if(size_.load(std::memory_order_relaxed) == capacity_) return false;
+            if(size_.load(std::memory_order_relaxed) == capacity_) {
+                push_mutex_.unlock();
+                return false;
+            }
             ring_buffer_[Normalize(write_next_++)] = obj;
             size_.fetch_add(1, std::memory_order_acq_rel);
             push_mutex_.unlock();
@@ -110,7 +114,10 @@ namespace pentifica::tbox {
         /// @return True if the instance added.
         bool TryPush(T& obj) {
             if(!push_mutex_.try_lock()) return false;
-            if(size_.load(std::memory_order_relaxed) == capacity_) return false;
+            if(size_.load(std::memory_order_relaxed) == capacity_) {
+                push_mutex_.unlock();
+                return false;
+            }
             ring_buffer_[Normalize(write_next_++)] = std::move(obj);
             size_.fetch_add(1, std::memory_order_acq_rel);
             push_mutex_.unlock();
@@ -152,4 +159,143 @@ namespace pentifica::tbox {
         mutex_type pop_mutex_;  //!< gatekeeper for pop
         Buffer ring_buffer_;    //!< The ring buffer
     };
+
+    /// @brief  Selects the single producer/single consumer RingBuffer when
+    ///         given as the mutex type: RingBuffer<T, RingBufferSpsc>
+    struct RingBufferSpsc {};
+
+    /** A lock-free circular buffer for exactly one pushing thread and one
+     *  popping thread. Each side owns its index, kept on its own cache line
+     *  with a cached copy of the other side's index, so a push or pop only
+     *  reads the other side's cache line when the cached copy says the ring
+     *  is full or empty. */
+    template<typename T, typename S>
+    requires RB_type_traits<T, RingBufferSpsc>
+    class RingBuffer<T, RingBufferSpsc, S> {
+    protected:
+        using Buffer = std::vector<T>;
+        using PopResult = std::optional<T>;
+        /// @brief  Keeps the producer and consumer state on separate cache lines
+        static constexpr std::size_t cache_line_size{64};
+
+    public:
+        /// @brief  Prepare an instance
+        /// @param  size    The capacity of the ring buffer
+        RingBuffer(S size)
+            : capacity_{size}
+            , ring_buffer_(size + 1)
+        {}
+        //  deleted operations
+        RingBuffer(RingBuffer const&) = delete;
+        RingBuffer(RingBuffer&&) = delete;
+        RingBuffer& operator=(RingBuffer const&) = delete;
+        RingBuffer& operator=(RingBuffer&&) = delete;
+        /// @brief  Release all resources
+        virtual ~RingBuffer() = default;
+        /// @brief Returns the number of items in the ring. While the other
+        ///        side is active the result may already be stale.
+        /// @return 
+        S Size() const {
+            auto const read = read_next_.load(std::memory_order_acquire);
+            auto const write = write_next_.load(std::memory_order_acquire);
+            return write >= read ? write - read : write + Slots() - read;
+        }
+        /// @brief  Returns the status of the buffer
+        /// @return Returnss true if the buffer is empty
+        bool Empty() const { return Size() == 0; }
+        /// @brief Returns the capacity of the ring
+        /// @return 
+        auto Capacity() const { return capacity_; }
+        /// @brief  Add an instance to the end of the ring. If the ring is at
+        ///         capacity, the thread is blocked until the instance can be
+        ///         added. Producer thread only.
+        /// @param obj  The instance to add
+        void Push(T const& obj) {
+            auto const write = write_next_.load(std::memory_order_relaxed);
+            auto const next = Advance(write);
+            while(next == cached_read_next_) {
+                cached_read_next_ = read_next_.load(std::memory_order_acquire);
+            }
+            ring_buffer_[write] = obj;
+            write_next_.store(next, std::memory_order_release);
+        }
+        void Push(T& obj) {
+            auto const write = write_next_.load(std::memory_order_relaxed);
+            auto const next = Advance(write);
+            while(next == cached_read_next_) {
+                cached_read_next_ = read_next_.load(std::memory_order_acquire);
+            }
+            ring_buffer_[write] = std::move(obj);
+            write_next_.store(next, std::memory_order_release);
+        }
+        /// @brief Try to add an instance to the end of the ring. If the ring is at
+        ///        capacity, the instance is not added and control flow returns to
+        ///        the caller. Producer thread only.
+        /// @param obj  The instance to add
+        /// @return True if the instance added.
+        bool TryPush(T const& obj) {
+            auto const write = write_next_.load(std::memory_order_relaxed);
+            auto const next = Advance(write);
+            if(!HasRoom(next)) return false;
+            ring_buffer_[write] = obj;
+            write_next_.store(next, std::memory_order_release);
+            return true;
+        }
+        bool TryPush(T& obj) {
+            auto const write = write_next_.load(std::memory_order_relaxed);
+            auto const next = Advance(write);
+            if(!HasRoom(next)) return false;
+            ring_buffer_[write] = std::move(obj);
+            write_next_.store(next, std::memory_order_release);
+            return true;
+        }
+        /// @brief  Returns the next item from the ring. If no item is available
+        ///         the thread is blocked until an item is available. Consumer
+        ///         thread only.
+        /// @return 
+        T Pop() {
+            auto const read = read_next_.load(std::memory_order_relaxed);
+            while(read == cached_write_next_) {
+                cached_write_next_ = write_next_.load(std::memory_order_acquire);
+            }
+            auto obj{std::move(ring_buffer_[read])};
+            read_next_.store(Advance(read), std::memory_order_release);
+            return obj;
+        }
+        /// @brief  Optionally returns the next item from the ring if available.
+        ///         If no next item available, std::nullopt is returned.
+        ///         Consumer thread only.
+        /// @return 
+        PopResult TryPop() {
+            auto const read = read_next_.load(std::memory_order_relaxed);
+            if(read == cached_write_next_) {
+                cached_write_next_ = write_next_.load(std::memory_order_acquire);
+                if(read == cached_write_next_) return std::nullopt;
+            }
+            PopResult obj{std::move(ring_buffer_[read])};
+            read_next_.store(Advance(read), std::memory_order_release);
+            return obj;
+        }
+
+    protected:
+        /// @brief  The ring holds one slot more than its capacity, so a full
+        ///         ring and an empty ring have different indices
+        S Slots() const { return capacity_ + 1; }
+        /// @brief  Returns the slot following index, without a division
+        S Advance(S index) const { return index + 1 == Slots() ? 0 : index + 1; }
+        /// @brief  Returns true if the producer may write the slot before next,
+        ///         refreshing the cached consumer index only when it says no
+        bool HasRoom(S next) {
+            if(next != cached_read_next_) return true;
+            cached_read_next_ = read_next_.load(std::memory_order_acquire);
+            return next != cached_read_next_;
+        }
+
+        alignas(cache_line_size) std::atomic<S> write_next_{};  //!< Next location to write to
+        S cached_read_next_{};          //!< The producer's copy of read_next_
+        alignas(cache_line_size) std::atomic<S> read_next_{};   //!< Next location to read from
+        S cached_write_next_{};         //!< The consumer's copy of write_next_
+        alignas(cache_line_size) S const capacity_;             //!< The size of the circular buffer
+        Buffer ring_buffer_;            //!< The ring buffer
+    };
 }
@@ -0,0 +1,426 @@
+#pragma once
+/// @copyright {2024, Russell J. Fleming. All rights reserved.}
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+#include    "SkipList.h"
+#include    "SkipListGen.h"
+
+#include    <algorithm>
+#include    <concepts>
+#include    <cstddef>
+#include    <functional>
+#include    <memory>
+#include    <mutex>
+#include    <new>
+#include    <optional>
+#include    <shared_mutex>
+#include    <utility>
+#include    <vector>
+
+namespace pentifica::tbox {
+    /// @brief  A router assigns every key to one of a fixed number of shards.
+    ///         An ordered router keeps the shards in key order: every key of
+    ///         shard i orders before every key of shard i + 1.
+    template<typename R, typename K>
+    concept SkipListRouter = requires(R const& router, K const& key) {
+        { router.Shards() } -> std::convertible_to<std::size_t>;
+        { router(key) } -> std::convertible_to<std::size_t>;
+        { R::ordered } -> std::convertible_to<bool>;
+    };
+
+    /// @brief  Routes keys by range. N ascending bounds split the key space
+    ///         into N + 1 shards: shard i holds the keys in
+    ///         [bounds[i - 1], bounds[i]).
+    /// @tparam K       The key type
+    /// @tparam Compare Orders the keys, as in the shards
+    template<typename K, typename Compare = std::less<K>>
+    class SkipListRangeRouter {
+    public:
+        static constexpr bool ordered{true};
+
+        /// @brief  Prepare an instance
+        /// @param  bounds  The first key of every shard but the first, ascending
+        /// @param  compare Orders the keys
+        explicit SkipListRangeRouter(std::vector<K> bounds, Compare compare = Compare{})
+            : bounds_(std::move(bounds))
+            , compare_(std::move(compare))
+        {}
+        /// @brief  Returns the number of shards
+        std::size_t Shards() const noexcept { return bounds_.size() + 1; }
+        /// @brief  Returns the shard holding a key
+        std::size_t operator()(K const& key) const {
+            return std::ranges::upper_bound(bounds_, key, compare_) - bounds_.begin();
+        }
+
+    private:
+        std::vector<K> bounds_;
+        [[no_unique_address]] Compare compare_;
+    };
+
+    /// @brief  Routes keys by hash, spreading skewed keys evenly. The shards
+    ///         are not in key order, so ordered scans merge every shard.
+    /// @tparam K       The key type
+    /// @tparam Hash    Hashes the keys
+    template<typename K, typename Hash = std::hash<K>>
+    class SkipListHashRouter {
+    public:
+        static constexpr bool ordered{false};
+
+        /// @brief  Prepare an instance
+        /// @param  shards  The number of shards
+        /// @param  hash    Hashes the keys
+        explicit SkipListHashRouter(std::size_t shards, Hash hash = Hash{})
+            : shards_(std::max<std::size_t>(shards, 1))
+            , hash_(std::move(hash))
+        {}
+        /// @brief  Returns the number of shards
+        std::size_t Shards() const noexcept { return shards_; }
+        /// @brief  Returns the shard holding a key
+        std::size_t operator()(K const& key) const { return hash_(key) % shards_; }
+
+    private:
+        std::size_t shards_{};
+        [[no_unique_address]] Hash hash_;
+    };
+
+    /// @brief  A map partitioning its keys across independent SkipList
+    ///         shards, each guarded by its own reader/writer lock, so writers
+    ///         to different shards never contend. Every operation on a single
+    ///         key locks only the shard the router assigns it to.
+    /// @tparam K       The key type
+    /// @tparam V       The value type
+    /// @tparam Router  Assigns keys to shards (see SkipListRouter)
+    /// @tparam Compare Orders the keys
+    /// @tparam Policy  The features of the shards (see SkipListPolicy). Readers
+    ///                 share a shard's lock, so a policy whose const searches
+    ///                 write to the list (instrumented) is rejected.
+    /// @tparam LevelGen    The level generator of a shard. Every shard has its
+    ///                 own, so generators need not be thread safe.
+    template<typename K, typename V,
+        typename Router = SkipListRangeRouter<K>,
+        typename Compare = std::less<K>,
+        typename Policy = SkipListPolicy,
+        typename LevelGen = SkipListFastLevelGenerator<>>
+    requires SkipNodeArgs<K, V> && SkipListRouter<Router, K> && (!Policy::instrumented)
+    class ShardedSkipList {
+    public:
+        using shard_type = SkipList<K, V, Compare, Policy, LevelGen>;
+        using value_type = typename shard_type::value_type;
+        using router_type = Router;
+        using key_compare = Compare;
+        /// @brief  Makes the level generator of a shard, given its index
+        using level_generator_factory = std::function<LevelGen(std::size_t)>;
+
+        /// @brief  Basic setup of an instance
+        /// @param  router      Assigns keys to shards; sets the number of shards
+        /// @param  max_level   Initial number of levels in each shard
+        /// @param  make_level_generator    Makes the level generator of a shard
+        /// @param  compare     Orders the keys
+        ShardedSkipList(Router router, int max_level,
+            level_generator_factory make_level_generator = [](std::size_t) { return LevelGen{}; },
+            Compare compare = Compare{});
+        ShardedSkipList(ShardedSkipList const&) = delete;
+        ShardedSkipList& operator=(ShardedSkipList const&) = delete;
+
+        /// @brief  Get a copy of the value associated with a key
+        /// @param  key     The lookup key
+        /// @return The value, or nullopt if the key is not found
+        std::optional<V> Find(K const& key) const {
+            auto& shard = ShardOf(key);
+            std::shared_lock lock(shard.mutex_);
+            //  the const lookup only reads; the other one erases expired nodes
+            auto value = std::as_const(shard.list_).Lookup(key);
+            return value != nullptr ? std::optional<V>(*value) : std::nullopt;
+        }
+        /// @brief  Returns true if the key is in the map
+        bool Contains(K const& key) const {
+            auto& shard = ShardOf(key);
+            std::shared_lock lock(shard.mutex_);
+            return std::as_const(shard.list_).Lookup(key) != nullptr;
+        }
+        /// @brief  Modify the value associated with a key in place, holding
+        ///         the shard's lock
+        /// @param  key     The lookup key
+        /// @param  modify  Invoked with a reference to the value
+        /// @return True if the key was found and the value updated
+        template<typename Modify>
+        requires std::invocable<Modify&, V&>
+        bool Update(K const& key, Modify&& modify) {
+            auto& shard = ShardOf(key);
+            std::unique_lock lock(shard.mutex_);
+            return shard.list_.Update(key, std::forward<Modify>(modify));
+        }
+        /// @brief  Insert a key-value pair, replacing the value of an existing key
+        /// @param  key
+        /// @param  value
+        /// @return True if the key was inserted
+        bool InsertOrAssign(K const& key, V value) {
+            auto& shard = ShardOf(key);
+            std::unique_lock lock(shard.mutex_);
+            return shard.list_.InsertOrAssign(key, std::move(value)).second;
+        }
+        /// @brief  Insert a key-value pair, keeping the value of an existing key
+        /// @param  key
+        /// @param  value
+        /// @return True if the key was inserted
+        bool TryEmplace(K const& key, V value) {
+            auto& shard = ShardOf(key);
+            std::unique_lock lock(shard.mutex_);
+            return shard.list_.TryEmplace(key, std::move(value)).second;
+        }
+        /// @brief  Insert key-value pairs, taking the lock of each shard once.
+        ///         Existing keys are given the new value.
+        /// @param  pairs   A range of (key, value) pairs, in any order
+        /// @return The number of keys inserted
+        template<typename Range>
+        std::size_t InsertBatch(Range&& pairs);
+        /// @brief  Delete a key-value pair
+        /// @param  key     The key to delete
+        /// @return NOERR, or KEY_NOT_FOUND
+        SkipListError::ErrorVariant Delete(K const& key) {
+            auto& shard = ShardOf(key);
+            std::unique_lock lock(shard.mutex_);
+            return shard.list_.Delete(key);
+        }
+
+        /// @brief  Visit, in key order, every node with a key in [first, last).
+        ///         An ordered router visits the shards covering the range one
+        ///         at a time, holding each shard's shared lock while visiting
+        ///         it. A hash router merges all shards, holding every shared
+        ///         lock for the scan.
+        /// @param  first   The first key of the range
+        /// @param  last    The key ending the range (not visited)
+        /// @param  visitor Invoked with each node (const). If it returns a
+        ///                 bool, the scan stops when it returns false.
+        /// @return The number of nodes visited
+        template<typename Visitor>
+        std::size_t ForEachInRange(K const& first, K const& last, Visitor&& visitor) const;
+        /// @brief  Visit every node in key order (see ForEachInRange)
+        /// @param  visitor Invoked with each node (const)
+        /// @return The number of nodes visited
+        template<typename Visitor>
+        std::size_t ForEach(Visitor&& visitor) const;
+
+        /// @brief  Returns the number of key-value pairs. Shards are counted
+        ///         one at a time, so concurrent writers may skew the total.
+        std::size_t Size() const {
+            std::size_t size{};
+            for(auto const& shard : shards_) {
+                std::shared_lock lock(shard->mutex_);
+                size += shard->list_.Size();
+            }
+            return size;
+        }
+        /// @brief  Returns true if there are no key-value pairs
+        bool Empty() const { return Size() == 0; }
+        /// @brief  Returns the number of shards
+        std::size_t Shards() const noexcept { return shards_.size(); }
+        /// @brief  Returns the number of key-value pairs in a shard
+        std::size_t ShardSize(std::size_t shard) const {
+            std::shared_lock lock(shards_[shard]->mutex_);
+            return shards_[shard]->list_.Size();
+        }
+        /// @brief  Returns the router
+        Router const& GetRouter() const noexcept { return router_; }
+
+    private:
+        /// @brief  A shard and its lock, on their own cache lines so shards
+        ///         written by different threads do not falsely share
+        struct alignas(64) Shard {
+            Shard(int max_level, LevelGen gen, Compare compare)
+                : list_(max_level, std::move(gen), std::move(compare))
+            {}
+            mutable std::shared_mutex mutex_;
+            shard_type list_;
+        };
+        using node_ptr = value_type const*;
+
+        Shard& ShardOf(K const& key) const { return *shards_[router_(key)]; }
+        /// @brief  Visit the nodes of [first, last) in key order, merging the
+        ///         shards. The caller holds the shared lock of every shard.
+        template<typename Visitor>
+        std::size_t MergeRange(K const* first, K const* last, Visitor& visitor) const;
+        /// @brief  Invoke the visitor with a node
+        /// @return False if the visitor asks to stop
+        template<typename Visitor>
+        static bool Visit(Visitor& visitor, value_type const& node) {
+            if constexpr(std::is_convertible_v<std::invoke_result_t<Visitor&, value_type const&>, bool>) {
+                return std::invoke(visitor, node);
+            }
+            else {
+                std::invoke(visitor, node);
+                return true;
+            }
+        }
+
+        Router router_;
+        [[no_unique_address]] Compare compare_;
+        std::vector<std::unique_ptr<Shard>> shards_;
+    };
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Router, typename Compare, typename Policy, typename LevelGen>
+    requires SkipNodeArgs<K, V> && SkipListRouter<Router, K> && (!Policy::instrumented)
+    ShardedSkipList<K, V, Router, Compare, Policy, LevelGen>::ShardedSkipList(Router router, int max_level,
+        level_generator_factory make_level_generator, Compare compare)
+        : router_(std::move(router))
+        , compare_(std::move(compare))
+    {
+        auto const shards = static_cast<std::size_t>(router_.Shards());
+        shards_.reserve(shards);
+        for(std::size_t shard = 0; shard < shards; ++shard) {
+            shards_.push_back(std::make_unique<Shard>(max_level, make_level_generator(shard), compare_));
+        }
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Router, typename Compare, typename Policy, typename LevelGen>
+    requires SkipNodeArgs<K, V> && SkipListRouter<Router, K> && (!Policy::instrumented)
+    template<typename Range>
+    std::size_t
+    ShardedSkipList<K, V, Router, Compare, Policy, LevelGen>::InsertBatch(Range&& pairs) {
+        //  group the pairs by shard, then apply each group under one lock
+        std::vector<std::vector<std::pair<K, V>>> groups(shards_.size());
+        for(auto&& [key, value] : pairs) {
+            groups[router_(key)].emplace_back(key, value);
+        }
+
+        std::size_t inserted{};
+        for(std::size_t shard = 0; shard < shards_.size(); ++shard) {
+            auto& group = groups[shard];
+            if(group.empty()) continue;
+            //  sorted input lets the shard resume each search from the last;
+            //  the sort is stable so the last value given for a key wins
+            std::ranges::stable_sort(group, compare_, [](auto const& pair) -> K const& { return pair.first; });
+            auto& list = shards_[shard]->list_;
+            std::unique_lock lock(shards_[shard]->mutex_);
+            auto const before = list.Size();
+            list.InsertBatch(group);
+            inserted += list.Size() - before;
+        }
+        return inserted;
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Router, typename Compare, typename Policy, typename LevelGen>
+    requires SkipNodeArgs<K, V> && SkipListRouter<Router, K> && (!Policy::instrumented)
+    template<typename Visitor>
+    std::size_t
+    ShardedSkipList<K, V, Router, Compare, Policy, LevelGen>::ForEachInRange(
+        K const& first, K const& last, Visitor&& visitor) const {
+        if(!compare_(first, last)) {
+            return 0;
+        }
+
+        if constexpr(Router::ordered) {
+            //  only the shards from the one holding first to the one holding
+            //  last can hold keys of the range
+            std::size_t visited{};
+            bool more{true};
+            for(auto shard = router_(first), final = router_(last); more && shard <= final; ++shard) {
+                std::shared_lock lock(shards_[shard]->mutex_);
+                auto const& list = shards_[shard]->list_;
+                for(auto it = list.LowerBound(first); it != list.end() && compare_(it->Key(), last); ++it) {
+                    ++visited;
+                    if(!(more = Visit(visitor, *it))) break;
+                }
+            }
+            return visited;
+        }
+        else {
+            std::vector<std::shared_lock<std::shared_mutex>> locks;
+            locks.reserve(shards_.size());
+            for(auto const& shard : shards_) {
+                locks.emplace_back(shard->mutex_);
+            }
+            return MergeRange(&first, &last, visitor);
+        }
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Router, typename Compare, typename Policy, typename LevelGen>
+    requires SkipNodeArgs<K, V> && SkipListRouter<Router, K> && (!Policy::instrumented)
+    template<typename Visitor>
+    std::size_t
+    ShardedSkipList<K, V, Router, Compare, Policy, LevelGen>::ForEach(Visitor&& visitor) const {
+        if constexpr(Router::ordered) {
+            std::size_t visited{};
+            for(auto const& shard : shards_) {
+                std::shared_lock lock(shard->mutex_);
+                for(auto const& node : shard->list_) {
+                    ++visited;
+                    if(!Visit(visitor, node)) return visited;
+                }
+            }
+            return visited;
+        }
+        else {
+            std::vector<std::shared_lock<std::shared_mutex>> locks;
+            locks.reserve(shards_.size());
+            for(auto const& shard : shards_) {
+                locks.emplace_back(shard->mutex_);
+            }
+            return MergeRange(nullptr, nullptr, visitor);
+        }
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Router, typename Compare, typename Policy, typename LevelGen>
+    requires SkipNodeArgs<K, V> && SkipListRouter<Router, K> && (!Policy::instrumented)
+    template<typename Visitor>
+    std::size_t
+    ShardedSkipList<K, V, Router, Compare, Policy, LevelGen>::MergeRange(
+        K const* first, K const* last, Visitor& visitor) const {
+        using cursor_type = std::pair<typename shard_type::const_iterator, typename shard_type::const_iterator>;
+
+        //  a min-heap of the next node of every shard
+        std::vector<cursor_type> heap;
+        heap.reserve(shards_.size());
+        for(auto const& shard : shards_) {
+            auto const& list = shard->list_;
+            auto begin = first != nullptr ? list.LowerBound(*first) : list.begin();
+            if(begin != list.end()) {
+                heap.emplace_back(begin, list.end());
+            }
+        }
+        auto later = [this](cursor_type const& lhs, cursor_type const& rhs) {
+            return compare_(rhs.first->Key(), lhs.first->Key());
+        };
+        std::ranges::make_heap(heap, later);
+
+        std::size_t visited{};
+        while(!heap.empty()) {
+            std::ranges::pop_heap(heap, later);
+            auto& [next, end] = heap.back();
+            if(last != nullptr && !compare_(next->Key(), *last)) {
+                //  the smallest remaining key is past the range
+                break;
+            }
+            ++visited;
+            if(!Visit(visitor, *next)) break;
+            if(++next != end) {
+                std::ranges::push_heap(heap, later);
+            }
+            else {
+                heap.pop_back();
+            }
+        }
+        return visited;
+    }
+}
@@ -24,47 +24,75 @@
 ///     https://en.wikipedia.org/wiki/Skip_list#:~:text=The%20expected%20number,against%20storage%20costs.
 #include    "SkipListNode.h"
 #include    "SkipListError.h"
+#include    "SkipListArena.h"
+#include    "SkipListGen.h"
 
+#include    <algorithm>
+#include    <array>
+#include    <bit>
+#include    <chrono>
 #include    <optional>
 #include    <expected>
 #include    <random>
 #include    <memory>
 #include    <functional>
+#include    <iterator>
+#include    <numeric>
+#include    <ranges>
 #include    <vector>
 
 namespace pentifica::tbox {
     /// @brief  Defines an iterator that does a forward traversal of the
     ///         SkipLisstNode(s) contained by a SkipLlist instance.
+    ///         Iterating a const list yields const nodes.
     /// @tparam SL  The SkipList type to iterate over
     template<typename SL>
     class SkipListIterator {
+        /// @brief  The node type, without the constness of the list
+        using node_type = typename SL::value_type;
+        /// @brief  Iterators of a const list are const iterators
+        static constexpr bool is_const{std::is_const_v<SL>};
+
     public:
-        using category = std::forward_iterator_tag;
+        using iterator_category = std::conditional_t<SL::policy_type::bidirectional,
+            std::bidirectional_iterator_tag, std::forward_iterator_tag>;
+        using iterator_concept = iterator_category;
+        using category = iterator_category;
 
         using container_type = SL;
         using container_ptr = container_type*;
 
-        using value_type = typename SL::value_type;
-        using reference = value_type&;
-        using pointer = value_type*;
+        using value_type = node_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<is_const, value_type const&, value_type&>;
+        using pointer = std::conditional_t<is_const, value_type const*, value_type*>;
 
+        /// @brief  Prepare an instance referring to no list
+        SkipListIterator() noexcept = default;
         /// @brief  Prepare an instance
         /// @param container 
         /// @param node 
-        SkipListIterator(container_ptr container, pointer node) noexcept
+        SkipListIterator(container_ptr container, node_type* node) noexcept
             : container_(container)
             , node_(node)
         {}
         /// @brief  Prepare an instance from and existing
         /// @param other    The instance to use for initialization
         SkipListIterator(SkipListIterator const& other) noexcept = default;
+        /// @brief  Prepare a const iterator from an iterator of the same list
+        /// @param other    The iterator to convert
+        SkipListIterator(SkipListIterator<std::remove_const_t<SL>> const& other) noexcept requires is_const
+            : container_(other.container_)
+            , node_(other.node_)
+        {}
+        SkipListIterator& operator=(SkipListIterator const& other) noexcept = default;
         /// @brief  Cleanup
         ~SkipListIterator() = default;
         /// @brief  Pre-increment  advance
         /// @return The advanced iterator
         SkipListIterator& operator++() noexcept {
             if(node_ != container_->end_sentinel_) {
-                node_ = node_->links_[0];
+                node_ = node_->Link(0);
             }
             return *this;
         }
@@ -76,45 +104,208 @@ namespace pentifica::tbox {
             ++(*this);
             return temp;
         }
-        bool operator==(SkipListIterator const& other) const noexcept {
-            return node_ == other.node_;
+        /// @brief  Pre-decrement: step back to the previous node.
+        ///         Bidirectional lists only.
+        /// @return The moved iterator
+        SkipListIterator& operator--() noexcept requires SL::policy_type::bidirectional {
+            node_ = SL::PrevLink(node_);
+            return *this;
+        }
+        /// @brief  Post-decrement
+        /// @param
+        /// @return
+        SkipListIterator operator--(int) noexcept requires SL::policy_type::bidirectional {
+            auto temp{*this};
+            --(*this);
+            return temp;
         }
-        bool operator!=(SkipListIterator const& other) const noexcept {
-            return !operator==(other);
+        /// @brief  Iterators are equal when they refer to the same node. An
+        ///         iterator compares with a const iterator through conversion.
+        friend bool operator==(SkipListIterator const& lhs, SkipListIterator const& rhs) noexcept {
+            return lhs.node_ == rhs.node_;
         }
         reference operator*() const noexcept { return *node_; }
         pointer operator->() const noexcept { return node_; }
 
     private:
+        template<typename>
+        friend class SkipListIterator;
+
         container_ptr container_{};
-        pointer node_{};
+        node_type* node_{};
+    };
+    /// @brief  Selects the optional features of a skip list. A policy derives
+    ///         from SkipListPolicy and redefines the flags it turns on, so
+    ///         features it does not mention keep their default.
+    struct SkipListPolicy {
+        /// @brief  Each link records the number of nodes it spans, enabling
+        ///         the O(log n) Rank, At and CountInRange queries
+        static constexpr bool indexable{false};
+        /// @brief  Searches count the links they follow and the key
+        ///         comparisons they make (see Counters)
+        static constexpr bool instrumented{false};
+        /// @brief  Each node links back to its predecessor, so iterators can
+        ///         move backward (operator--, rbegin, rend)
+        static constexpr bool bidirectional{false};
+        /// @brief  Each step of a search prefetches the node it drops to
+        ///         should it leave the current level. A lone descent has
+        ///         little but the key comparison to hide a miss behind, so
+        ///         this is off by default; FindInterleaved prefetches
+        ///         regardless.
+        static constexpr bool prefetching{false};
+        /// @brief  Entries can be given an expiry time, after which searches
+        ///         treat them as deleted and EvictExpired removes them
+        static constexpr bool expiring{false};
+        /// @brief  The clock expiry times are read from
+        using clock_type = std::chrono::steady_clock;
+    };
+    /// @brief  A policy for an order-statistic skip list
+    struct SkipListIndexable : SkipListPolicy {
+        static constexpr bool indexable{true};
+    };
+    /// @brief  A policy for a skip list that can be traversed in both directions
+    struct SkipListBidirectional : SkipListPolicy {
+        static constexpr bool bidirectional{true};
+    };
+    /// @brief  A policy for a skip list whose entries can expire
+    struct SkipListExpiring : SkipListPolicy {
+        static constexpr bool expiring{true};
+    };
+    /// @brief  A policy for a skip list that counts its search costs
+    struct SkipListInstrumented : SkipListPolicy {
+        static constexpr bool instrumented{true};
+    };
+
+    /// @brief  The shape and size of a skip list (see SkipList::Stats)
+    struct SkipListStats {
+        /// @brief  Number of key/value pairs
+        std::size_t size{};
+        /// @brief  Number of levels holding at least one node
+        int levels{};
+        /// @brief  Number of levels a new node can be given
+        int max_level{};
+        /// @brief  Number of nodes whose tower reaches each level; with a
+        ///         p-factor of p, each entry is about p times the one before
+        std::vector<std::size_t> nodes_per_level{};
+        /// @brief  Bytes occupied by the nodes and sentinels, towers included
+        std::size_t node_bytes{};
+        /// @brief  Bytes of node_bytes taken by the towers (the links and
+        ///         whatever the policy stores with them)
+        std::size_t tower_bytes{};
+        /// @brief  Bytes reserved from the heap by the node arena
+        std::size_t arena_bytes{};
+        /// @brief  Links a Find follows to reach a key, averaged over the keys
+        double average_find_hops{};
+        /// @brief  Most links a Find follows to reach a key
+        std::size_t max_find_hops{};
+    };
+
+    /// @brief  Search costs recorded by an instrumented skip list. Every
+    ///         operation that descends the list (Find, Lookup, Update, the
+    ///         inserts, Delete, the bounds, the batches and the rank queries)
+    ///         counts as a search.
+    struct SkipListCounters {
+        /// @brief  Number of searches
+        std::size_t searches{};
+        /// @brief  Links followed by the searches
+        std::size_t hops{};
+        /// @brief  Most links followed by a single search
+        std::size_t max_hops{};
+        /// @brief  Key comparisons made, including those made by ForEachInRange
+        ///         and BulkLoad
+        std::size_t comparisons{};
     };
+    /// @brief  Stands in for the counters of a list that is not instrumented
+    struct SkipListNoCounters {};
+    /// @brief  Stands in for the expiry queue of a list whose entries do not expire
+    struct SkipListNoExpiry {};
+
     /// @brief  Defines a skip list
     /// @tparam K   The key type
     /// @tparam V   The value type
-    template<typename K, typename V>
+    /// @tparam Compare Strict weak ordering of the keys. Keys are equivalent
+    ///         when neither orders before the other; operator== is never used.
+    /// @tparam Policy  The optional features (see SkipListPolicy)
+    /// @tparam LevelGen    Invoked with the number of levels to draw the level
+    ///         (0 .. max_level-1) of a new node. The default accepts any callable
+    ///         through type erasure; naming the generator's own type (e.g.
+    ///         SkipListFastLevelGenerator) lets the call be inlined.
+    template<typename K, typename V, typename Compare = std::less<K>,
+        typename Policy = SkipListPolicy, typename LevelGen = std::function<int(int)>>
     requires SkipNodeArgs<K, V>
     class SkipList {
     public:
         using value_type = SkipListNode<K, V>;
-        using iterator = SkipListIterator<SkipList<K, V>>;
-        using const_iterator = SkipListIterator<const SkipList<K, V>>;
+        using key_compare = Compare;
+        using policy_type = Policy;
+        using level_generator_type = LevelGen;
+        using clock_type = typename Policy::clock_type;
+        using time_point = typename clock_type::time_point;
+        using iterator = SkipListIterator<SkipList<K, V, Compare, Policy, LevelGen>>;
+        using const_iterator = SkipListIterator<const SkipList<K, V, Compare, Policy, LevelGen>>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
         friend iterator;
+        friend const_iterator;
 
     public:
         /// @brief  Basic setup of an instance
-        /// @param  max_level   Number of levels in the skiplist
+        /// @param  max_level   Initial number of levels in the skiplist
         /// @param  gen_next_skip_level  Generates a skip level (0 .. max_level - 1)
-        /// @note Levels are numbered from 0 .. max_level-1
-        SkipList(int max_level, std::function<int(int)> gen_next_skip_level);
+        /// @note Levels are numbered from 0 .. max_level-1. The number of levels
+        ///       grows with the list, one level each time the size passes
+        ///       2^max_level, up to skip_list_level_limit.
+        /// @param  compare     Orders the keys
+        SkipList(int max_level, LevelGen gen_next_skip_level, Compare compare = Compare{});
+        SkipList(SkipList const&) = delete;
+        SkipList& operator=(SkipList const&) = delete;
+        /// @brief  Take over the nodes of another list. The other list is left
+        ///         without nodes and may only be destroyed.
+        /// @param  other   The list to take the nodes from
+        SkipList(SkipList&& other) noexcept;
+        SkipList& operator=(SkipList&&) = delete;
         /// @brief  Instance cleanup
         ~SkipList();
 
         /// @brief  Get the value associated with a particular key
-        /// @param  key     The lookup key
+        /// @param  key     The lookup key, or any probe comparable with K
         /// @return An optional value referencing the value associated with the key
+        template<typename Q = K>
+        requires SkipListKeyComparable<K, Q, Compare>
         std::optional<V>
-        Find(K const& key);
+        Find(Q const& key);
+
+        /// @brief  Get the value associated with a particular key without copying it
+        /// @param  key     The lookup key, or any probe comparable with K
+        /// @return The address of the value, nullptr if the key is not found.
+        ///         It remains valid until the key is deleted.
+        template<typename Q = K>
+        requires SkipListKeyComparable<K, Q, Compare>
+        V* Lookup(Q const& key) {
+            auto node = FindLiveNode(Probe(key));
+            return node != nullptr ? &node->value_ : nullptr;
+        }
+        template<typename Q = K>
+        requires SkipListKeyComparable<K, Q, Compare>
+        V const* Lookup(Q const& key) const {
+            auto node = FindNode(Probe(key));
+            return node != nullptr && !Expired(node) ? &node->value_ : nullptr;
+        }
+
+        /// @brief  Modify the value associated with a key in place
+        /// @param  key     The lookup key, or any probe comparable with K
+        /// @param  modify  Invoked with a reference to the value
+        /// @return True if the key was found and the value updated
+        template<typename Q = K, typename Modify>
+        requires SkipListKeyComparable<K, Q, Compare> && std::invocable<Modify&, V&>
+        bool Update(Q const& key, Modify&& modify) {
+            auto node = FindLiveNode(Probe(key));
+            if(node == nullptr) {
+                return false;
+            }
+            std::invoke(modify, node->value_);
+            return true;
+        }
 
         /// @brief  Insert a key-value pair
         /// @param key 
@@ -123,25 +314,292 @@ namespace pentifica::tbox {
         V
         Insert(K const& key, V const& value);
 
+        /// @brief  Insert a key with a value constructed in place, or replace
+        ///         the value of an existing key with one constructed in place
+        /// @param  key     The key, or an argument for constructing it
+        /// @param  args    The arguments for constructing the value
+        /// @return The node's iterator and true if a node was inserted
+        template<typename KK, typename... Args>
+        requires SkipListKeyComparable<K, KK, Compare> && std::constructible_from<K, KK&&>
+            && std::constructible_from<V, Args&&...>
+        std::pair<iterator, bool>
+        Emplace(KK&& key, Args&&... args);
+
+        /// @brief  Insert a key with a value constructed in place. Nothing is
+        ///         constructed if the key exists.
+        /// @param  key     The key, or an argument for constructing it
+        /// @param  args    The arguments for constructing the value
+        /// @return The node's iterator and true if a node was inserted
+        template<typename KK, typename... Args>
+        requires SkipListKeyComparable<K, KK, Compare> && std::constructible_from<K, KK&&>
+            && std::constructible_from<V, Args&&...>
+        std::pair<iterator, bool>
+        TryEmplace(KK&& key, Args&&... args);
+
+        /// @brief  Insert a key-value pair, or assign the value to an existing key
+        /// @param  key     The key, or an argument for constructing it
+        /// @param  value   The value, forwarded into the node
+        /// @return The node's iterator and true if a node was inserted
+        template<typename KK, typename M>
+        requires SkipListKeyComparable<K, KK, Compare> && std::constructible_from<K, KK&&>
+            && std::constructible_from<V, M&&> && std::is_assignable_v<V&, M&&>
+        std::pair<iterator, bool>
+        InsertOrAssign(KK&& key, M&& value);
+
+        /// @brief  Load key-value pairs supplied in ascending key order. Nodes
+        ///         are appended level by level in a single pass, without a
+        ///         search or a call to the level generator; node n (counting
+        ///         from 1) is given the level countr_zero(n), producing the
+        ///         layout of a perfectly balanced list with p = 1/2.
+        /// @param  sorted  A range (e.g. a container or a Generator) of pair-like
+        ///                 key-value elements. A repeated key updates the value;
+        ///                 an out of order key, or a non-empty list, falls back
+        ///                 to Insert.
+        /// @return The number of elements read from the range
+        template<typename Range>
+        std::size_t BulkLoad(Range&& sorted);
+
+        /// @brief  Insert a batch of key-value pairs supplied in ascending key
+        ///         order. Each search resumes from the predecessors found for
+        ///         the previous key (a finger), so nearby keys cost
+        ///         O(log distance) rather than O(log n).
+        /// @param  sorted  A range of pair-like key-value elements. An out of
+        ///                 order key restarts the search from the list head.
+        /// @return The number of elements read from the range
+        template<typename Range>
+        std::size_t InsertBatch(Range&& sorted);
+
+        /// @brief  Get the values associated with a batch of keys supplied in
+        ///         ascending order, using the same finger search as InsertBatch
+        /// @param  sorted  A range of keys. An out of order key restarts the
+        ///                 search from the list head.
+        /// @return The lookup result for each key, in input order
+        template<typename Range>
+        std::vector<std::optional<V>> FindBatch(Range&& sorted);
+
+        /// @brief  Get the values associated with a batch of keys in any
+        ///         order. Up to search_group descents run interleaved, one
+        ///         step of each in turn, and every step prefetches the node
+        ///         its descent compares next, so the cache misses of
+        ///         independent searches overlap (group prefetching).
+        /// @param  keys    A forward range of keys, or probes comparable with K
+        /// @return The value found for each key (nullopt if none), in the
+        ///         order of the keys
+        template<std::ranges::forward_range Range>
+        std::vector<std::optional<V>> FindInterleaved(Range&& keys) const;
+
+        /// @brief  Number of searches FindInterleaved runs at once
+        static constexpr std::size_t search_group{16};
+
         /// @brief Delete a key-value pair from the list
         /// @param key The key to delete
         /// @return 
+        template<typename Q = K>
+        requires SkipListKeyComparable<K, Q, Compare>
         SkipListError::ErrorVariant
-        Delete(K const& key);
+        Delete(Q const& key);
+
+        /// @brief  Returns an iterator to the first node whose key is not less than key
+        /// @param  key     The lookup key, or any probe comparable with K
+        /// @return The iterator, end() if there is no such node
+        template<typename Q = K>
+        requires SkipListKeyComparable<K, Q, Compare>
+        iterator LowerBound(Q const& key) { return iterator(this, SeekNode(Probe(key), false)); }
+        template<typename Q = K>
+        requires SkipListKeyComparable<K, Q, Compare>
+        const_iterator LowerBound(Q const& key) const { return const_iterator(this, SeekNode(Probe(key), false)); }
+
+        /// @brief  Returns an iterator to the first node whose key is greater than key
+        /// @param  key     The lookup key, or any probe comparable with K
+        /// @return The iterator, end() if there is no such node
+        template<typename Q = K>
+        requires SkipListKeyComparable<K, Q, Compare>
+        iterator UpperBound(Q const& key) { return iterator(this, SeekNode(Probe(key), true)); }
+        template<typename Q = K>
+        requires SkipListKeyComparable<K, Q, Compare>
+        const_iterator UpperBound(Q const& key) const { return const_iterator(this, SeekNode(Probe(key), true)); }
+
+        /// @brief  Returns the range of nodes whose key is equivalent to key
+        /// @param  key     The lookup key, or any probe comparable with K
+        /// @return The [LowerBound, UpperBound) iterator pair
+        template<typename Q = K>
+        requires SkipListKeyComparable<K, Q, Compare>
+        std::pair<iterator, iterator> EqualRange(Q const& key) {
+            return {LowerBound(key), UpperBound(key)};
+        }
+        template<typename Q = K>
+        requires SkipListKeyComparable<K, Q, Compare>
+        std::pair<const_iterator, const_iterator> EqualRange(Q const& key) const {
+            return {LowerBound(key), UpperBound(key)};
+        }
+
+        /// @brief  Visit, in key order, every node with a key in [first, last)
+        /// @param  first   The first key of the range
+        /// @param  last    The key ending the range (not visited)
+        /// @param  visitor Invoked with each node. If it returns a bool, the
+        ///                 scan stops when it returns false.
+        /// @return The number of nodes visited
+        template<typename Visitor>
+        std::size_t ForEachInRange(K const& first, K const& last, Visitor&& visitor);
+
+        /// @brief  Returns the number of keys ordered before key, which is the
+        ///         zero-based position of LowerBound(key). Indexable lists only.
+        /// @param  key     The lookup key, or any probe comparable with K
+        template<typename Q = K>
+        requires Policy::indexable && SkipListKeyComparable<K, Q, Compare>
+        std::size_t Rank(Q const& key) const { return RankOf(Probe(key)); }
+
+        /// @brief  Returns an iterator to the node at a zero-based position in
+        ///         key order. Indexable lists only.
+        /// @param  index   The position of the node
+        /// @return The iterator, end() if index is not less than Size()
+        iterator At(std::size_t index) requires Policy::indexable {
+            return iterator(this, NodeAt(index));
+        }
+        const_iterator At(std::size_t index) const requires Policy::indexable {
+            return const_iterator(this, NodeAt(index));
+        }
+
+        /// @brief  Returns the number of keys in [first, last). Indexable lists only.
+        /// @param  first   The first key of the range
+        /// @param  last    The key ending the range
+        template<typename Q = K>
+        requires Policy::indexable && SkipListKeyComparable<K, Q, Compare>
+        std::size_t CountInRange(Q const& first, Q const& last) const {
+            auto from = Rank(first);
+            auto to = Rank(last);
+            return to > from ? to - from : 0;
+        }
 
         /// @brief Returns true if the list is empty.
         /// @return 
         bool Empty() const {
-            return begin_sentinel_->links_[0] == end_sentinel_;
+            return begin_sentinel_->Link(0) == end_sentinel_;
         }
 
         /// @brief  Returns the number of key/value pairs in the list
         /// @return
         auto Size() const { return count_; }
 
+        /// @brief  Move every node of other into this list. Keys in both
+        ///         lists take the value from other, as when applying a newer
+        ///         delta to a base list. Each node is linked with a finger
+        ///         search that resumes from the previous node, so merging m
+        ///         keys into n costs O(m log(n/m)) and no node is copied.
+        /// @param  other   The list to move the nodes from; it is left empty
+        /// @return The number of nodes moved into this list
+        std::size_t Merge(SkipList& other) { return Splice(other, true); }
+
+        /// @brief  Move every node of other with a key not in this list into
+        ///         this list. Keys in both lists keep this list's value.
+        /// @param  other   The list to move the nodes from; it is left empty
+        /// @return The number of nodes moved into this list
+        std::size_t Union(SkipList& other) { return Splice(other, false); }
+
+        /// @brief  Remove the keys not in other from this list. Walks this
+        ///         list once, searching other with a finger.
+        /// @param  other   The list holding the keys to keep
+        /// @return The number of keys removed
+        std::size_t Intersect(SkipList const& other);
+
+        /// @brief  Remove the keys in other from this list. Walks other once,
+        ///         searching this list with a finger.
+        /// @param  other   The list holding the keys to remove
+        /// @return The number of keys removed
+        std::size_t Difference(SkipList const& other);
+
+        /// @brief  Cut the list in two: the keys ordered before key stay, the
+        ///         others move to the returned list. The nodes are relinked in
+        ///         O(log n). An indexable list also counts the two parts in
+        ///         O(log n); any other list walks the shorter part, O(n) for a
+        ///         cut near the middle. An expiring list also divides its
+        ///         expiry queue. The returned list's level generator is a copy
+        ///         reseeded from this list's generator (see ForkLevelGenerator).
+        /// @param  key     The first key of the returned list
+        /// @return The list holding the keys not ordered before key
+        SkipList Split(K const& key);
+
+        /// @brief  Gather the shape and size of the list. Walks every node.
+        /// @return The statistics
+        SkipListStats Stats() const;
+
+        /// @brief  Returns the search costs recorded so far. Instrumented lists only.
+        /// @return
+        SkipListCounters const& Counters() const noexcept requires Policy::instrumented {
+            return counters_;
+        }
+        /// @brief  Restart the search cost counts. Instrumented lists only.
+        void ResetCounters() noexcept requires Policy::instrumented { counters_ = {}; }
+
+        /// @brief  Insert a key-value pair that expires at a given time, or
+        ///         assign the value and expiry time to an existing key.
+        ///         Expiring lists only.
+        /// @param  key     The key, or an argument for constructing it
+        /// @param  value   The value, forwarded into the node
+        /// @param  expires When the entry expires
+        /// @return The node's iterator and true if a node was inserted
+        template<typename KK, typename M>
+        requires Policy::expiring && SkipListKeyComparable<K, KK, Compare> && std::constructible_from<K, KK&&>
+            && std::constructible_from<V, M&&> && std::is_assignable_v<V&, M&&>
+        std::pair<iterator, bool>
+        InsertOrAssign(KK&& key, M&& value, time_point expires) {
+            auto result = InsertOrAssign(std::forward<KK>(key), std::forward<M>(value));
+            Expiry(&*result.first) = expires;
+            QueueExpiry(&*result.first);
+            return result;
+        }
+
+        /// @brief  Set the time an entry expires. Expiring lists only.
+        /// @param  key     The lookup key, or any probe comparable with K
+        /// @param  expires When the entry expires; time_point::max() for never
+        /// @return True if the key was found (and had not expired)
+        template<typename Q = K>
+        requires Policy::expiring && SkipListKeyComparable<K, Q, Compare>
+        bool ExpireAt(Q const& key, time_point expires) {
+            auto node = FindLiveNode(Probe(key));
+            if(node == nullptr) {
+                return false;
+            }
+            Expiry(node) = expires;
+            QueueExpiry(node);
+            return true;
+        }
+
+        /// @brief  Returns the time an entry expires. Expiring lists only.
+        /// @param  key     The lookup key, or any probe comparable with K
+        /// @return The expiry time (time_point::max() for never), nullopt if
+        ///         the key is not found or has expired
+        template<typename Q = K>
+        requires Policy::expiring && SkipListKeyComparable<K, Q, Compare>
+        std::optional<time_point> ExpiryOf(Q const& key) const {
+            auto node = FindNode(Probe(key));
+            return node != nullptr && !Expired(node) ? std::optional(Expiry(node)) : std::nullopt;
+        }
+
+        /// @brief  Remove expired entries, soonest expiry first, taking at
+        ///         most budget entries from the expiry queue. A queued entry
+        ///         whose key was since deleted or given another expiry time
+        ///         is dropped and counts against the budget, so each call
+        ///         does at most budget searches. Expiring lists only.
+        /// @note   Searches skip expired entries whether evicted or not, but
+        ///         iteration, Size() and the rank queries see an entry until
+        ///         it is evicted or deleted.
+        /// @param  budget  The most queue entries to examine
+        /// @param  now     The current time
+        /// @return The number of entries removed
+        std::size_t EvictExpired(std::size_t budget, time_point now = clock_type::now())
+            requires Policy::expiring;
+
+        /// @brief  Returns the number of levels holding at least one node
+        ///         (at least 1); searches start at the highest of them
+        /// @return
+        auto Levels() const { return top_level_; }
+        /// @brief  Returns the ordering of the keys
+        Compare const& GetCompare() const noexcept { return compare_; }
+
         /// @brief  Returns an iterator initialized to the start of the list
         /// @return
-        iterator begin() { return iterator(this, begin_sentinel_->links_[0]); }
+        iterator begin() { return iterator(this, begin_sentinel_->Link(0)); }
 
         /// @brief  Returns an iterator initialized to 1 past the end of the l;ist
         /// @return
@@ -149,141 +607,1171 @@ namespace pentifica::tbox {
 
         /// @brief  Returns a const iterator initialized o the start of the list
         /// @return
-        const_iterator begin() const { return const_iterator(this, begin_sentinel_->links_[0]); }
+        const_iterator begin() const { return const_iterator(this, begin_sentinel_->Link(0)); }
 
         /// @briefReeeeturns a const iterator initialized to 1 past the end of the list
         const_iterator end() const { return const_iterator(this, end_sentinel_); }
 
+        /// @brief  Returns a const iterator initialized to the start of the list
+        /// @return
+        const_iterator cbegin() const { return begin(); }
+
+        /// @brief  Returns a const iterator initialized to 1 past the end of the list
+        /// @return
+        const_iterator cend() const { return end(); }
+
+        /// @brief  Returns a reverse iterator at the last node of the list.
+        ///         Bidirectional lists only.
+        /// @return
+        reverse_iterator rbegin() requires Policy::bidirectional { return reverse_iterator(end()); }
+        const_reverse_iterator rbegin() const requires Policy::bidirectional { return const_reverse_iterator(end()); }
+
+        /// @brief  Returns a reverse iterator 1 before the start of the list.
+        ///         Bidirectional lists only.
+        /// @return
+        reverse_iterator rend() requires Policy::bidirectional { return reverse_iterator(begin()); }
+        const_reverse_iterator rend() const requires Policy::bidirectional { return const_reverse_iterator(begin()); }
+
     private:
-        std::pair<value_type*, std::vector<value_type*>>
-        IdentifyPredecessorNode(K const& key);
+        /// @brief  The predecessor of a key at each level
+        using update_type = std::array<value_type*, skip_list_level_limit>;
+
+        template<typename Q>
+        std::pair<value_type*, update_type>
+        IdentifyPredecessorNode(Q const& key);
+
+        /// @brief  Move the predecessors in update forward to the predecessors
+        ///         of key, starting the descent at the highest level whose
+        ///         predecessor is stale. Entries of update that are not
+        ///         before key are reset to the list head first.
+        /// @return The first node with a key not less than key
+        template<typename Q>
+        value_type* AdvanceFinger(Q const& key, update_type& update) const;
+
+        /// @brief  Returns the node holding key, nullptr if there is none
+        template<typename Q>
+        value_type* FindNode(Q const& key) const;
+
+        /// @brief  Returns the node holding key, nullptr if there is none. An
+        ///         expired node is deleted on the way.
+        template<typename Q>
+        value_type* FindLiveNode(Q const& key) {
+            auto node = FindNode(key);
+            if(node != nullptr && Expired(node)) {
+                EraseNode(node);
+                return nullptr;
+            }
+            return node;
+        }
+        /// @brief  Unlink and release a node found earlier
+        void EraseNode(value_type* node) {
+            auto update = IdentifyPredecessorNode(node->key_).second;
+            UnlinkNode(update, node);
+            DestroyNode(node);
+            ShrinkLevels();
+        }
+        /// @brief  An expired node given a new value no longer expires
+        static void Revive([[maybe_unused]] value_type* node) {
+            if constexpr(Policy::expiring) {
+                if(Expired(node)) {
+                    Expiry(node) = time_point::max();
+                }
+            }
+        }
+        /// @brief  Queue a node's expiry time for EvictExpired. The queue is
+        ///         rebuilt from the list when stale entries make up most of it.
+        void QueueExpiry(value_type const* node);
+        /// @brief  Orders the expiry queue as a min-heap
+        static bool ExpiresLater(std::pair<time_point, K> const& lhs, std::pair<time_point, K> const& rhs) noexcept {
+            return rhs.first < lhs.first;
+        }
+
+        /// @brief  Ask for the cache line of a node ahead of its use
+        static void Prefetch([[maybe_unused]] value_type const* node) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            __builtin_prefetch(node, 0, 3);
+#endif
+        }
+        /// @brief  Returns the node following node at a level. With a
+        ///         prefetching policy, the node's successor on the level
+        ///         below, where the descent goes once next is past the key,
+        ///         is prefetched while the caller compares next. Its address
+        ///         is in node, so the prefetch does not wait on next.
+        value_type* NextAt(value_type const* node, int level) const noexcept {
+            auto next = node->Link(level);
+            if constexpr(Policy::prefetching) {
+                if(level > 0) {
+                    Prefetch(node->Link(level - 1));
+                }
+            }
+            return next;
+        }
+
+        /// @brief  Returns a copy of the level generator drawing its own
+        ///         sequence. The seed is drawn from this list's generator, so
+        ///         a seeded list still splits reproducibly. A generator with a
+        ///         Seed member is reseeded, as is a std::function holding one
+        ///         of the generators of SkipListGen.h; any other is copied as
+        ///         it is and repeats this list's levels.
+        LevelGen ForkLevelGenerator() {
+            std::uint64_t seed{0xcbf29ce484222325ull};
+            for(int draw = 0; draw < 64; ++draw) {
+                seed = (seed ^ static_cast<std::uint64_t>(gen_next_skip_level_(skip_list_level_limit))) * 0x100000001b3ull;
+            }
+
+            auto generator{gen_next_skip_level_};
+            auto reseed = [seed](auto* target) {
+                if(target != nullptr) target->Seed(seed);
+                return target != nullptr;
+            };
+            if constexpr(requires { generator.Seed(seed); }) {
+                generator.Seed(seed);
+            }
+            else if constexpr(std::is_same_v<LevelGen, std::function<int(int)>>) {
+                reseed(generator.template target<SkipListLevelGenerator>())
+                    || reseed(generator.template target<SkipListFastLevelGenerator<1>>())
+                    || reseed(generator.template target<SkipListFastLevelGenerator<2>>());
+            }
+            return generator;
+        }
+
+        /// @brief  Identify the last node at each level
+        update_type IdentifyTailNodes() const;
+
+        /// @brief  Returns the number of keys ordered before key
+        template<typename Q>
+        std::size_t RankOf(Q const& key) const;
+
+        /// @brief  Returns the node at a zero-based position, the end sentinel
+        ///         if there is none
+        value_type* NodeAt(std::size_t index) const;
+
+        /// @brief  Recompute every span width in a single pass over level 0
+        void RebuildWidths();
+
+        /// @brief  Returns the storage following a node's links: the backward
+        ///         link of a bidirectional list, then the span widths of an
+        ///         indexable list
+        static std::byte* Trailer(value_type const* node) noexcept {
+            return reinterpret_cast<std::byte*>(node->LinksData() + node->current_level_ + 1);
+        }
+        /// @brief  Bytes of the trailer taken by the backward link
+        static constexpr std::size_t prev_link_size{Policy::bidirectional ? sizeof(value_type*) : 0};
+        /// @brief  Returns the link to the previous node at level 0.
+        ///         Bidirectional lists only.
+        static value_type*& PrevLink(value_type const* node) noexcept {
+            return *std::launder(reinterpret_cast<value_type**>(Trailer(node)));
+        }
+        /// @brief  Set the backward link of a node in a bidirectional list
+        static void SetPrev([[maybe_unused]] value_type* node, [[maybe_unused]] value_type* prev) noexcept {
+            if constexpr(Policy::bidirectional) {
+                PrevLink(node) = prev;
+            }
+        }
+        /// @brief  Returns the span widths stored after a node's links. The
+        ///         width of the link at a level is the number of level 0 hops
+        ///         it covers. Indexable lists only.
+        static std::size_t* Widths(value_type const* node) noexcept {
+            return std::launder(reinterpret_cast<std::size_t*>(Trailer(node) + prev_link_size));
+        }
+        static std::size_t& Width(value_type const* node, int level) noexcept {
+            return Widths(node)[level];
+        }
+        /// @brief  Bytes of the trailer taken by the span widths of a node
+        static constexpr std::size_t WidthsSize(int level) noexcept {
+            return Policy::indexable ? (level + 1) * sizeof(std::size_t) : 0;
+        }
+        /// @brief  Bytes of the trailer taken by the expiry time
+        static constexpr std::size_t expiry_size{Policy::expiring ? sizeof(time_point) : 0};
+        /// @brief  Returns the time a node expires, time_point::max() if it
+        ///         never does. Expiring lists only; stored after the widths.
+        static time_point& Expiry(value_type const* node) noexcept {
+            return *std::launder(reinterpret_cast<time_point*>(
+                Trailer(node) + prev_link_size + WidthsSize(node->current_level_)));
+        }
+        /// @brief  Returns true if a node has expired
+        static bool Expired([[maybe_unused]] value_type const* node) {
+            if constexpr(Policy::expiring) {
+                auto const expiry = Expiry(node);
+                return expiry != time_point::max() && expiry <= clock_type::now();
+            }
+            else {
+                return false;
+            }
+        }
+        /// @brief  Returns the number of bytes in a node's tower: its links,
+        ///         plus its backward link in a bidirectional list, its span
+        ///         widths in an indexable list and its expiry time in an
+        ///         expiring list
+        static constexpr std::size_t TowerSize(int level) noexcept {
+            return (level + 1) * sizeof(value_type*) + prev_link_size + WidthsSize(level) + expiry_size;
+        }
+        /// @brief  Returns the number of bytes needed for a node and its tower
+        static constexpr std::size_t NodeSize(int level) noexcept {
+            return value_type::AllocationSize(level) - (level + 1) * sizeof(value_type*) + TowerSize(level);
+        }
+
+        /// @brief  Descend to the first node with a key not less than key, or
+        ///         if after is set, to the first node with a key greater than key
+        template<typename Q>
+        value_type* SeekNode(Q const& key, bool after) const;
+
+        /// @brief  Create a node in storage taken from the node arena
+        template<typename KK, typename... Args>
+        value_type* CreateNode(int level, KK&& key, Args&&... args) {
+            auto node = value_type::Emplace(arena_->Allocate(NodeSize(level), level),
+                level, std::forward<KK>(key), std::forward<Args>(args)...);
+            if constexpr(Policy::bidirectional) {
+                ::new(Trailer(node)) value_type*{nullptr};
+            }
+            if constexpr(Policy::indexable) {
+                std::uninitialized_fill_n(reinterpret_cast<std::size_t*>(Trailer(node) + prev_link_size),
+                    level + 1, std::size_t{1});
+            }
+            if constexpr(Policy::expiring) {
+                ::new(Trailer(node) + prev_link_size + WidthsSize(level)) time_point{time_point::max()};
+            }
+            return node;
+        }
+        /// @brief  Link a new node after the predecessors in update
+        template<typename KK, typename... Args>
+        value_type* LinkNewNode(update_type const& update, KK&& key, Args&&... args) {
+            GrowLevels();
+            auto level = gen_next_skip_level_(max_level_);
+            auto new_node = CreateNode(level, std::forward<KK>(key), std::forward<Args>(args)...);
+            LinkNode(update, new_node);
+            return new_node;
+        }
+        /// @brief  Link a node after the predecessors in update, keeping its level
+        void LinkNode(update_type const& update, value_type* new_node) {
+            auto const level = new_node->current_level_;
+            if constexpr(Policy::indexable) {
+                //  offset is the number of nodes from update[i] to update[0];
+                //  update[i - 1] is reached from update[i] along level i - 1
+                std::size_t offset{};
+                for(int i = 0; i < max_level_; i++) {
+                    if(i > 0) {
+                        for(auto node = update[i]; node != update[i - 1]; node = node->Link(i - 1)) {
+                            offset += Width(node, i - 1);
+                        }
+                    }
+                    if(i <= level) {
+                        Width(new_node, i) = Width(update[i], i) - offset;
+                        Width(update[i], i) = offset + 1;
+                    }
+                    else {
+                        ++Width(update[i], i);
+                    }
+                }
+            }
+            for(int i = 0; i <= level; i++) {
+                new_node->Link(i) = update[i]->Link(i);
+                update[i]->Link(i) = new_node;
+            }
+            SetPrev(new_node, update[0]);
+            SetPrev(new_node->Link(0), new_node);
+            top_level_ = std::max(top_level_, level + 1);
+            ++count_;
+        }
+        /// @brief  Unlink a node from the predecessors in update; the caller
+        ///         releases it
+        void UnlinkNode(update_type const& update, value_type* node) {
+            for(int i = 0; i < max_level_; i++) {
+                if(update[i]->Link(i) != node) {
+                    if constexpr(Policy::indexable) {
+                        --Width(update[i], i);
+                        continue;
+                    }
+                    break;
+                }
+                if constexpr(Policy::indexable) {
+                    Width(update[i], i) += Width(node, i) - 1;
+                }
+                update[i]->Link(i) = node->Link(i);
+            }
+            SetPrev(node->Link(0), update[0]);
+            --count_;
+        }
+        /// @brief  Lower the top level past levels left without a node
+        void ShrinkLevels() {
+            while(top_level_ > 1 && begin_sentinel_->Link(top_level_ - 1) == end_sentinel_) {
+                --top_level_;
+            }
+        }
+        /// @brief  Raise the level cap to at least max_level
+        void RaiseLevelCap(int max_level) {
+            while(max_level_ < max_level) {
+                if constexpr(Policy::indexable) {
+                    Width(begin_sentinel_, max_level_) = count_ + 1;
+                }
+                ++max_level_;
+            }
+        }
+        /// @brief  Leave the list without nodes; the nodes are not released
+        void Detach() noexcept {
+            for(int i = 0; i < skip_list_level_limit; i++) {
+                begin_sentinel_->Link(i) = end_sentinel_;
+            }
+            SetPrev(end_sentinel_, begin_sentinel_);
+            if constexpr(Policy::indexable) {
+                std::fill_n(Widths(begin_sentinel_), skip_list_level_limit, std::size_t{1});
+            }
+            count_ = 0;
+            top_level_ = 1;
+            if constexpr(Policy::expiring) {
+                expiry_queue_.clear();
+            }
+        }
+        /// @brief  Keep the arenas holding another list's nodes alive, so its
+        ///         nodes can be moved into this list
+        void ShareArenas(SkipList const& other) {
+            for(auto const& arena : other.arenas_) {
+                if(std::ranges::find(arenas_, arena) == arenas_.end()) {
+                    arenas_.push_back(arena);
+                }
+            }
+        }
+        /// @brief  Move the nodes of other into this list
+        /// @param  replace Keys in both lists take the value from other
+        std::size_t Splice(SkipList& other, bool replace);
+        /// @brief  Add a level each time the size passes 2^max_level. The
+        ///         begin sentinel has a link at every level up to the limit
+        ///         already, so a level is added by raising max_level.
+        void GrowLevels() {
+            while(max_level_ < skip_list_level_limit && count_ >= (std::size_t{1} << max_level_)) {
+                if constexpr(Policy::indexable) {
+                    Width(begin_sentinel_, max_level_) = count_ + 1;
+                }
+                ++max_level_;
+            }
+        }
+        /// @brief  Converts a probe to K once when the comparator would otherwise
+        ///         convert it on every comparison
+        template<typename Q>
+        static decltype(auto) Probe(Q const& key) {
+            if constexpr(ConvertsProbe<Q>) {
+                return K(key);
+            }
+            else {
+                return (key);
+            }
+        }
+        template<typename Q>
+        static constexpr bool ConvertsProbe = !std::same_as<Q, K>
+            && !requires { typename Compare::is_transparent; }
+            && std::constructible_from<K, Q const&>;
+
+        /// @brief  Orders two keys, counting the comparison in an instrumented list
+        template<typename A, typename B>
+        bool Less(A const& lhs, B const& rhs) const {
+            if constexpr(Policy::instrumented) {
+                ++counters_.comparisons;
+            }
+            return compare_(lhs, rhs);
+        }
+        /// @brief  Records a search that followed hops links; instrumented lists only
+        void CountSearch([[maybe_unused]] std::size_t hops) const noexcept {
+            if constexpr(Policy::instrumented) {
+                ++counters_.searches;
+                counters_.hops += hops;
+                counters_.max_hops = std::max(counters_.max_hops, hops);
+            }
+        }
+
+        /// @brief  Returns true if node holds key; node must not precede key
+        template<typename Q>
+        bool Matches(value_type const* node, Q const& key) const {
+            return node != end_sentinel_ && !Less(key, node->key_);
+        }
+        /// @brief  Return a node's storage to the node arena
+        void DestroyNode(value_type* node) {
+            auto level = node->Level();
+            std::destroy_at(node);
+            arena_->Deallocate(node, level);
+        }
 
     public:
+        /// @brief  Where this list's nodes are allocated. Storage of released
+        ///         nodes, including nodes moved in from other lists, is
+        ///         recycled through this arena.
+        std::shared_ptr<SkipListArena> arena_{std::make_shared<SkipListArena>()};
+        /// @brief  Every arena holding one of this list's nodes, arena_ first
+        std::vector<std::shared_ptr<SkipListArena>> arenas_{arena_};
         size_t count_{};
         value_type* begin_sentinel_{};
         value_type* end_sentinel_{};
-        const int max_level_{};
-        std::function<int(int)> gen_next_skip_level_{};
+        int max_level_{};
+        int top_level_{1};
+        LevelGen gen_next_skip_level_;
+        [[no_unique_address]] Compare compare_{};
+        [[no_unique_address]] mutable
+            std::conditional_t<Policy::instrumented, SkipListCounters, SkipListNoCounters> counters_{};
+        /// @brief  A min-heap of (expiry, key), soonest first. An entry goes
+        ///         stale when its key is deleted or given another expiry
+        ///         time; stale entries are dropped when they reach the top.
+        [[no_unique_address]]
+            std::conditional_t<Policy::expiring, std::vector<std::pair<time_point, K>>, SkipListNoExpiry> expiry_queue_{};
     };
 
     //  ------------------------------------------------------------------------
     //
-    template<typename K, typename V>
+    template<typename K, typename V, typename Compare, typename Policy, typename LevelGen>
     requires SkipNodeArgs<K, V>
-    SkipList<K, V>::SkipList(int max_level, std::function<int(int)> gen_next_skip_level)
-        : max_level_(max_level)
-        , gen_next_skip_level_(gen_next_skip_level)
+    SkipList<K, V, Compare, Policy, LevelGen>::SkipList(int max_level, LevelGen gen_next_skip_level, Compare compare)
+        : max_level_(std::clamp(max_level, 1, skip_list_level_limit))
+        , gen_next_skip_level_(std::move(gen_next_skip_level))
+        , compare_(std::move(compare))
     {
-        begin_sentinel_ = new SkipListNode<K, V>(max_level_ - 1, {}, {});
-        end_sentinel_ = new SkipListNode<K, V>(max_level_ - 1, {}, {});
+        static_assert(value_type::Alignment() <= SkipListArena::block_alignment);
+        static_assert(std::is_invocable_r_v<int, LevelGen&, int>);
+
+        //  the begin sentinel is as tall as any list can grow; the end
+        //  sentinel's links are never followed
+        begin_sentinel_ = CreateNode(skip_list_level_limit - 1, K{});
+        end_sentinel_ = CreateNode(0, K{});
     
         //  connect start and end nodes
-        for(auto& link : begin_sentinel_->links_) {
-            link = end_sentinel_;
+        for(int i = 0; i < skip_list_level_limit; i++) {
+            begin_sentinel_->Link(i) = end_sentinel_;
         }
+        SetPrev(end_sentinel_, begin_sentinel_);
     }
     //  ------------------------------------------------------------------------
     //
-    template<typename K, typename V>
+    template<typename K, typename V, typename Compare, typename Policy, typename LevelGen>
     requires SkipNodeArgs<K, V>
-    SkipList<K, V>::~SkipList() {
-        for(auto node = begin_sentinel_->links_[0];
-            node != end_sentinel_;
-            node = begin_sentinel_->links_[0]) {
-    
-            //  move node links to begin_sentinel_
-            for(int i = 0; i < max_level_; i++) {
-                if(begin_sentinel_->links_[i] != node) {
-                    break;
-                }
-                begin_sentinel_->links_[i] = node->links_[i];
+    SkipList<K, V, Compare, Policy, LevelGen>::~SkipList() {
+        //  the arena returns the node storage to the heap in one step; the
+        //  nodes only need visiting when their key or value has a destructor
+        if constexpr(!std::is_trivially_destructible_v<K> || !std::is_trivially_destructible_v<V>) {
+            if(begin_sentinel_ == nullptr) {
+                return;
             }
-    
-            delete node;
+            for(auto node = begin_sentinel_; node != end_sentinel_;) {
+                auto next = node->Link(0);
+                std::destroy_at(node);
+                node = next;
+            }
+            std::destroy_at(end_sentinel_);
         }
-    
-        delete begin_sentinel_;
-        delete end_sentinel_;
     }
     //  ------------------------------------------------------------------------
     //
-    template<typename K, typename V>
+    template<typename K, typename V, typename Compare, typename Policy, typename LevelGen>
     requires SkipNodeArgs<K, V>
-    std::pair<SkipListNode<K, V>*, std::vector<SkipListNode<K, V>*>>
-    SkipList<K, V>::IdentifyPredecessorNode(K const& key) {
-        //  initialize the update vector
-        auto update = std::vector<SkipListNode<K, V>*>(max_level_, nullptr);
+    SkipList<K, V, Compare, Policy, LevelGen>::SkipList(SkipList&& other) noexcept
+        : arena_(other.arena_)
+        , arenas_(std::move(other.arenas_))
+        , count_(std::exchange(other.count_, 0))
+        , begin_sentinel_(std::exchange(other.begin_sentinel_, nullptr))
+        , end_sentinel_(std::exchange(other.end_sentinel_, nullptr))
+        , max_level_(other.max_level_)
+        , top_level_(other.top_level_)
+        , gen_next_skip_level_(std::move(other.gen_next_skip_level_))
+        , compare_(std::move(other.compare_))
+        , counters_(other.counters_)
+        , expiry_queue_(std::move(other.expiry_queue_))
+    {
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare, typename Policy, typename LevelGen>
+    requires SkipNodeArgs<K, V>
+    template<typename Q>
+    std::pair<SkipListNode<K, V>*, typename SkipList<K, V, Compare, Policy, LevelGen>::update_type>
+    SkipList<K, V, Compare, Policy, LevelGen>::IdentifyPredecessorNode(Q const& key) {
+        //  the update vector lives on the stack so no search allocates; the
+        //  predecessor at each empty level is the list head
+        update_type update;
+        std::fill(update.begin() + top_level_, update.end(), begin_sentinel_);
     
         //  see if the node already exists
         auto current_node{begin_sentinel_};
+        std::size_t hops{};
     
-        for(auto current_level = max_level_ - 1; current_level >= 0; current_level--) {
+        for(auto current_level = top_level_ - 1; current_level >= 0; current_level--) {
     
             //  check if the next node in the level has a key that comes
             //  before our search key
-            auto next_node = current_node->links_[current_level];
-            while(next_node != end_sentinel_ && next_node->key_ < key) {
+            auto next_node = NextAt(current_node, current_level);
+            while(next_node != end_sentinel_ && Less(next_node->key_, key)) {
                 current_node = next_node;
-                next_node = current_node->links_[current_level];
+                next_node = NextAt(current_node, current_level);
+                ++hops;
             }
     
             update[current_level] = current_node;
         }
     
-        current_node = current_node->links_[0];
+        CountSearch(hops);
+        current_node = current_node->Link(0);
     
         return {current_node, update};
     }
     //  ------------------------------------------------------------------------
     //
-    template<typename K, typename V>
+    template<typename K, typename V, typename Compare, typename Policy, typename LevelGen>
     requires SkipNodeArgs<K, V>
-    V
-    SkipList<K, V>::Insert(K const& key, V const& value) {
-    
-        //  Figure out where to insert the node: This is either the node
-        //  with the same key, so we can update the value, or we found
-        //  the node right before the insertion point so that we can
-        //  insert after it.
-        auto [current_node, update] = IdentifyPredecessorNode(key);
-    
-        //  if the key exists at the curent node, update its value
-        if(current_node->key_ == key) {
-            current_node->value_ = value;
+    template<typename Q>
+    SkipListNode<K, V>*
+    SkipList<K, V, Compare, Policy, LevelGen>::SeekNode(Q const& key, bool after) const {
+        auto current{begin_sentinel_};
+        std::size_t hops{};
+
+        for(auto search_level = top_level_ - 1; search_level >= 0; search_level--) {
+            for(auto next = NextAt(current, search_level);
+                next != end_sentinel_ && (after ? !Less(key, next->key_) : Less(next->key_, key));
+                next = NextAt(current, search_level)) {
+                current = next;
+                ++hops;
+            }
+        }
+
+        CountSearch(hops);
+        return current->Link(0);
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare, typename Policy, typename LevelGen>
+    requires SkipNodeArgs<K, V>
+    template<typename Visitor>
+    std::size_t
+    SkipList<K, V, Compare, Policy, LevelGen>::ForEachInRange(K const& first, K const& last, Visitor&& visitor) {
+        std::size_t visited{};
+
+        for(auto node = SeekNode(first, false);
+            node != end_sentinel_ && Less(node->key_, last);
+            node = node->Link(0)) {
+            ++visited;
+            if constexpr(std::is_convertible_v<std::invoke_result_t<Visitor&, value_type&>, bool>) {
+                if(!std::invoke(visitor, *node)) break;
+            }
+            else {
+                std::invoke(visitor, *node);
+            }
+        }
+
+        return visited;
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare, typename Policy, typename LevelGen>
+    requires SkipNodeArgs<K, V>
+    typename SkipList<K, V, Compare, Policy, LevelGen>::update_type
+    SkipList<K, V, Compare, Policy, LevelGen>::IdentifyTailNodes() const {
+        update_type tail;
+        tail.fill(begin_sentinel_);
+        auto current{begin_sentinel_};
+
+        for(auto current_level = top_level_ - 1; current_level >= 0; current_level--) {
+            while(current->Link(current_level) != end_sentinel_) {
+                current = current->Link(current_level);
+            }
+            tail[current_level] = current;
+        }
+
+        return tail;
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare, typename Policy, typename LevelGen>
+    requires SkipNodeArgs<K, V>
+    std::size_t
+    SkipList<K, V, Compare, Policy, LevelGen>::Splice(SkipList& other, bool replace) {
+        if(&other == this || other.Empty()) {
+            return 0;
+        }
+
+        //  the moved nodes keep their levels and their storage
+        ShareArenas(other);
+        RaiseLevelCap(other.max_level_);
+
+        std::size_t moved{};
+        update_type update;
+        update.fill(begin_sentinel_);
+
+        for(auto node = other.begin_sentinel_->Link(0); node != other.end_sentinel_;) {
+            auto next = node->Link(0);
+            auto current = AdvanceFinger(node->key_, update);
+
+            if(Matches(current, node->key_)) {
+                if(replace) {
+                    current->value_ = std::move(node->value_);
+                    if constexpr(Policy::expiring) {
+                        Expiry(current) = Expiry(node);
+                    }
+                }
+                other.DestroyNode(node);
+            }
+            else {
+                LinkNode(update, node);
+                for(int i = 0; i <= node->current_level_; i++) {
+                    update[i] = node;
+                }
+                ++moved;
+            }
+            node = next;
+        }
+
+        //  the moved nodes' queued expiry times come with them
+        if constexpr(Policy::expiring) {
+            expiry_queue_.insert(expiry_queue_.end(), std::make_move_iterator(other.expiry_queue_.begin()),
+                std::make_move_iterator(other.expiry_queue_.end()));
+            std::ranges::make_heap(expiry_queue_, ExpiresLater);
+        }
+        other.Detach();
+        GrowLevels();
+        return moved;
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare, typename Policy, typename LevelGen>
+    requires SkipNodeArgs<K, V>
+    std::size_t
+    SkipList<K, V, Compare, Policy, LevelGen>::Intersect(SkipList const& other) {
+        if(&other == this) {
+            return 0;
+        }
+
+        //  tail[i] is the last node kept at level i
+        update_type tail;
+        tail.fill(begin_sentinel_);
+        update_type finger;
+        finger.fill(other.begin_sentinel_);
+        std::size_t removed{};
+
+        for(auto node = begin_sentinel_->Link(0); node != end_sentinel_;) {
+            auto next = node->Link(0);
+            if(other.Matches(other.AdvanceFinger(node->key_, finger), node->key_)) {
+                SetPrev(node, tail[0]);
+                for(int i = 0; i <= node->current_level_; i++) {
+                    tail[i]->Link(i) = node;
+                    tail[i] = node;
+                }
+            }
+            else {
+                DestroyNode(node);
+                ++removed;
+            }
+            node = next;
+        }
+        for(int i = 0; i < max_level_; i++) {
+            tail[i]->Link(i) = end_sentinel_;
+        }
+        SetPrev(end_sentinel_, tail[0]);
+
+        count_ -= removed;
+        ShrinkLevels();
+        if constexpr(Policy::indexable) {
+            RebuildWidths();
+        }
+        return removed;
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare, typename Policy, typename LevelGen>
+    requires SkipNodeArgs<K, V>
+    std::size_t
+    SkipList<K, V, Compare, Policy, LevelGen>::Difference(SkipList const& other) {
+        if(&other == this) {
+            auto removed = count_;
+            for(auto node = begin_sentinel_->Link(0); node != end_sentinel_;) {
+                auto next = node->Link(0);
+                DestroyNode(node);
+                node = next;
+            }
+            Detach();
+            return removed;
+        }
+
+        update_type update;
+        update.fill(begin_sentinel_);
+        std::size_t removed{};
+
+        for(auto other_node = other.begin_sentinel_->Link(0); other_node != other.end_sentinel_;
+            other_node = other_node->Link(0)) {
+            auto node = AdvanceFinger(other_node->key_, update);
+            if(Matches(node, other_node->key_)) {
+                UnlinkNode(update, node);
+                DestroyNode(node);
+                ++removed;
+            }
+        }
+
+        ShrinkLevels();
+        return removed;
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare, typename Policy, typename LevelGen>
+    requires SkipNodeArgs<K, V>
+    SkipList<K, V, Compare, Policy, LevelGen>
+    SkipList<K, V, Compare, Policy, LevelGen>::Split(K const& key) {
+        SkipList result(max_level_, ForkLevelGenerator(), compare_);
+        auto [first, update] = IdentifyPredecessorNode(key);
+
+        //  offset[i] is the number of nodes from update[i] to update[0], which
+        //  gives the widths either side of the cut in an indexable list
+        std::array<std::size_t, skip_list_level_limit> offset{};
+        if constexpr(Policy::indexable) {
+            for(int i = 1; i < max_level_; i++) {
+                offset[i] = offset[i - 1];
+                for(auto node = update[i]; node != update[i - 1]; node = node->Link(i - 1)) {
+                    offset[i] += Width(node, i - 1);
+                }
+            }
+        }
+
+        //  the nodes after the cut keep linking to this list's end sentinel
+        //  at the top of each level, so the returned list takes it over and
+        //  this list continues with the returned list's end sentinel
+        std::swap(end_sentinel_, result.end_sentinel_);
+        for(int i = 0; i < skip_list_level_limit; i++) {
+            if(i < max_level_) {
+                result.begin_sentinel_->Link(i) = update[i]->Link(i);
+                if constexpr(Policy::indexable) {
+                    Width(result.begin_sentinel_, i) = Width(update[i], i) - offset[i];
+                    Width(update[i], i) = offset[i] + 1;
+                }
+                update[i]->Link(i) = end_sentinel_;
+            }
+            else {
+                result.begin_sentinel_->Link(i) = result.end_sentinel_;
+                begin_sentinel_->Link(i) = end_sentinel_;
+            }
+        }
+        SetPrev(result.begin_sentinel_->Link(0), result.begin_sentinel_);
+        SetPrev(end_sentinel_, update[0]);
+
+        //  both lists now hold nodes from both arenas
+        result.ShareArenas(*this);
+        ShareArenas(result);
+
+        //  the queued expiry times follow their keys
+        if constexpr(Policy::expiring) {
+            auto moved = std::ranges::partition(expiry_queue_,
+                [this, &key](auto const& entry) { return Less(entry.second, key); });
+            result.expiry_queue_.assign(std::make_move_iterator(moved.begin()), std::make_move_iterator(moved.end()));
+            expiry_queue_.erase(moved.begin(), moved.end());
+            std::ranges::make_heap(expiry_queue_, ExpiresLater);
+            std::ranges::make_heap(result.expiry_queue_, ExpiresLater);
+        }
+
+        //  count the shorter part by walking both parts in step
+        std::size_t kept{};
+        if constexpr(Policy::indexable) {
+            kept = RankOf(key);
         }
-    
-        //  The key doesn't exist at the current node, insert it
-        //  Update all pointers in the reachability chain to reach this node
         else {
-            auto level = gen_next_skip_level_(max_level_);
-            auto new_node = new SkipListNode<K, V>(level, key, value);
+            auto left = begin_sentinel_->Link(0);
+            auto right = result.begin_sentinel_->Link(0);
+            std::size_t steps{};
+            while(left != end_sentinel_ && right != result.end_sentinel_) {
+                left = left->Link(0);
+                right = right->Link(0);
+                ++steps;
+            }
+            kept = left == end_sentinel_ ? steps : count_ - steps;
+        }
+        result.count_ = count_ - kept;
+        count_ = kept;
+        result.top_level_ = top_level_;
+        ShrinkLevels();
+        result.ShrinkLevels();
+        return result;
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare, typename Policy, typename LevelGen>
+    requires SkipNodeArgs<K, V>
+    SkipListStats
+    SkipList<K, V, Compare, Policy, LevelGen>::Stats() const {
+        auto tower_size = [](int level) { return TowerSize(level); };
+
+        SkipListStats stats{
+            .size = count_,
+            .levels = top_level_,
+            .max_level = max_level_,
+            .nodes_per_level = std::vector<std::size_t>(top_level_),
+            .node_bytes = NodeSize(begin_sentinel_->current_level_) + NodeSize(end_sentinel_->current_level_),
+            .tower_bytes = tower_size(begin_sentinel_->current_level_) + tower_size(end_sentinel_->current_level_),
+            .arena_bytes = arena_->Footprint(),
+        };
+
+        //  a Find for a key moves right at level i past every node reaching
+        //  exactly level i since the last taller node; moves[i] counts those
+        //  nodes for the next key in order
+        std::array<std::size_t, skip_list_level_limit> moves{};
+        std::size_t total_hops{};
+
+        for(auto node = begin_sentinel_->Link(0); node != end_sentinel_; node = node->Link(0)) {
+            auto const level = node->current_level_;
             for(int i = 0; i <= level; i++) {
-                new_node->links_[i] = update[i]->links_[i];
-                update[i]->links_[i] = new_node;
+                ++stats.nodes_per_level[i];
+            }
+            stats.node_bytes += NodeSize(level);
+            stats.tower_bytes += tower_size(level);
+
+            auto const hops = std::accumulate(moves.begin(), moves.begin() + top_level_, std::size_t{});
+            total_hops += hops;
+            stats.max_find_hops = std::max(stats.max_find_hops, hops);
+            std::fill_n(moves.begin(), level, 0);
+            ++moves[level];
+        }
+
+        if(count_ != 0) {
+            stats.average_find_hops = static_cast<double>(total_hops) / count_;
+        }
+        return stats;
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare, typename Policy, typename LevelGen>
+    requires SkipNodeArgs<K, V>
+    template<typename Q>
+    std::size_t
+    SkipList<K, V, Compare, Policy, LevelGen>::RankOf(Q const& key) const {
+        std::size_t rank{};
+        auto current{begin_sentinel_};
+        std::size_t hops{};
+
+        for(auto search_level = top_level_ - 1; search_level >= 0; search_level--) {
+            for(auto next = current->Link(search_level);
+                next != end_sentinel_ && Less(next->key_, key);
+                next = current->Link(search_level)) {
+                rank += Width(current, search_level);
+                current = next;
+                ++hops;
             }
+        }
+
+        CountSearch(hops);
+        return rank;
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare, typename Policy, typename LevelGen>
+    requires SkipNodeArgs<K, V>
+    SkipListNode<K, V>*
+    SkipList<K, V, Compare, Policy, LevelGen>::NodeAt(std::size_t index) const {
+        if(index >= count_) {
+            return end_sentinel_;
+        }
+
+        //  positions count from the list head, so the node at index is index + 1
+        //  hops away; the end sentinel is always further than that
+        auto const position = index + 1;
+        std::size_t traversed{};
+        auto current{begin_sentinel_};
+        std::size_t hops{};
+
+        for(auto search_level = top_level_ - 1; search_level >= 0; search_level--) {
+            while(traversed + Width(current, search_level) <= position) {
+                traversed += Width(current, search_level);
+                current = current->Link(search_level);
+                ++hops;
+            }
+        }
+
+        CountSearch(hops);
+        return current;
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare, typename Policy, typename LevelGen>
+    requires SkipNodeArgs<K, V>
+    void
+    SkipList<K, V, Compare, Policy, LevelGen>::RebuildWidths() {
+        //  last[i] is the last node seen at level i and at[i] its position
+        update_type last;
+        std::array<std::size_t, skip_list_level_limit> at{};
+        std::fill_n(last.begin(), max_level_, begin_sentinel_);
+        std::size_t position{};
+
+        for(auto node = begin_sentinel_->Link(0); node != end_sentinel_; node = node->Link(0)) {
+            ++position;
+            for(int i = 0; i <= node->current_level_; i++) {
+                Width(last[i], i) = position - at[i];
+                last[i] = node;
+                at[i] = position;
+            }
+        }
+        for(int i = 0; i < max_level_; i++) {
+            Width(last[i], i) = position + 1 - at[i];
+        }
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare, typename Policy, typename LevelGen>
+    requires SkipNodeArgs<K, V>
+    template<typename Range>
+    std::size_t
+    SkipList<K, V, Compare, Policy, LevelGen>::BulkLoad(Range&& sorted) {
+        std::size_t read{};
+
+        if(!Empty()) {
+            for(auto&& [key, value] : sorted) {
+                Insert(key, value);
+                ++read;
+            }
+            return read;
+        }
+
+        //  tail[i] is the last node linked at level i
+        update_type tail;
+        tail.fill(begin_sentinel_);
+        std::size_t appended{};
+
+        for(auto&& [key, value] : sorted) {
+            ++read;
+            auto last = tail[0];
+
+            if(last != begin_sentinel_ && !Less(last->key_, key)) {
+                if(!Less(key, last->key_)) {
+                    last->value_ = value;
+                }
+                else {
+                    Insert(key, value);
+                    tail = IdentifyTailNodes();
+                }
+                continue;
+            }
+
+            GrowLevels();
+            auto level = std::min(std::countr_zero(++appended), max_level_ - 1);
+            auto new_node = CreateNode(level, key, value);
+            SetPrev(new_node, tail[0]);
+            SetPrev(end_sentinel_, new_node);
+            for(int i = 0; i <= level; i++) {
+                new_node->Link(i) = end_sentinel_;
+                tail[i]->Link(i) = new_node;
+                tail[i] = new_node;
+            }
+            top_level_ = std::max(top_level_, level + 1);
             ++count_;
         }
-    
+
+        if constexpr(Policy::indexable) {
+            RebuildWidths();
+        }
+        return read;
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare, typename Policy, typename LevelGen>
+    requires SkipNodeArgs<K, V>
+    template<typename Q>
+    SkipListNode<K, V>*
+    SkipList<K, V, Compare, Policy, LevelGen>::AdvanceFinger(Q const& key, update_type& update) const {
+        //  the finger only moves forward; predecessors are ordered by level so
+        //  checking level 0 covers them all
+        if(update[0] != begin_sentinel_ && !Less(update[0]->key_, key)) {
+            update.fill(begin_sentinel_);
+        }
+
+        //  a predecessor is stale when its successor is still before key. A
+        //  stale level implies every lower level is stale, so climb from level
+        //  0 to the first level that is not stale; the cost grows with the
+        //  distance moved rather than with the list size
+        auto top{0};
+        for(; top < max_level_; top++) {
+            auto next = update[top]->Link(top);
+            if(next == end_sentinel_ || !Less(next->key_, key)) {
+                break;
+            }
+        }
+        --top;
+
+        auto current = top >= 0 ? update[top] : update[0];
+        std::size_t hops{};
+        for(auto current_level = top; current_level >= 0; current_level--) {
+            //  resume from whichever of the old predecessor and the node
+            //  reached so far is further along
+            auto finger = update[current_level];
+            if(current == begin_sentinel_
+                || (finger != begin_sentinel_ && Less(current->key_, finger->key_))) {
+                current = finger;
+            }
+
+            auto next_node = NextAt(current, current_level);
+            while(next_node != end_sentinel_ && Less(next_node->key_, key)) {
+                current = next_node;
+                next_node = NextAt(current, current_level);
+                ++hops;
+            }
+
+            update[current_level] = current;
+        }
+
+        CountSearch(hops);
+        return update[0]->Link(0);
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare, typename Policy, typename LevelGen>
+    requires SkipNodeArgs<K, V>
+    template<typename Range>
+    std::size_t
+    SkipList<K, V, Compare, Policy, LevelGen>::InsertBatch(Range&& sorted) {
+        std::size_t read{};
+        update_type update;
+        update.fill(begin_sentinel_);
+
+        for(auto&& [key, value] : sorted) {
+            ++read;
+            auto current_node = AdvanceFinger(key, update);
+
+            if(Matches(current_node, key)) {
+                current_node->value_ = value;
+                Revive(current_node);
+                continue;
+            }
+
+            //  the new node precedes every later key in the batch
+            auto new_node = LinkNewNode(update, key, value);
+            for(int i = 0; i <= new_node->current_level_; i++) {
+                update[i] = new_node;
+            }
+        }
+
+        return read;
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare, typename Policy, typename LevelGen>
+    requires SkipNodeArgs<K, V>
+    template<typename Range>
+    std::vector<std::optional<V>>
+    SkipList<K, V, Compare, Policy, LevelGen>::FindBatch(Range&& sorted) {
+        std::vector<std::optional<V>> found;
+        if constexpr(std::ranges::sized_range<Range>) {
+            found.reserve(std::ranges::size(sorted));
+        }
+
+        update_type update;
+        update.fill(begin_sentinel_);
+
+        for(auto&& key : sorted) {
+            auto current = AdvanceFinger(key, update);
+            if(Matches(current, key) && !Expired(current)) {
+                found.emplace_back(current->value_);
+            }
+            else {
+                found.emplace_back(std::nullopt);
+            }
+        }
+
+        return found;
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare, typename Policy, typename LevelGen>
+    requires SkipNodeArgs<K, V>
+    V
+    SkipList<K, V, Compare, Policy, LevelGen>::Insert(K const& key, V const& value) {
+        InsertOrAssign(key, value);
         return value;
     }
     //  ------------------------------------------------------------------------
     //
-    template<typename K, typename V>
+    template<typename K, typename V, typename Compare, typename Policy, typename LevelGen>
     requires SkipNodeArgs<K, V>
-    std::optional<V>
-    SkipList<K, V>::Find(K const& key) {
-        auto current{begin_sentinel_};
-    
-        for(auto search_level = max_level_ - 1; search_level >= 0; search_level--) {
-            while(current->links_[search_level] != end_sentinel_
-                && current->links_[search_level]->key_ < key) {
-                current = current->links_[search_level];
+    template<typename KK, typename... Args>
+    requires SkipListKeyComparable<K, KK, Compare> && std::constructible_from<K, KK&&>
+        && std::constructible_from<V, Args&&...>
+    std::pair<typename SkipList<K, V, Compare, Policy, LevelGen>::iterator, bool>
+    SkipList<K, V, Compare, Policy, LevelGen>::Emplace(KK&& key, Args&&... args) {
+        if constexpr(ConvertsProbe<std::remove_cvref_t<KK>>) {
+            return Emplace(K(std::forward<KK>(key)), std::forward<Args>(args)...);
+        }
+        else {
+            auto [current_node, update] = IdentifyPredecessorNode(key);
+
+            //  if the key exists, replace its value with the one built in place
+            if(Matches(current_node, key)) {
+                auto const expired = Expired(current_node);
+                current_node->value_ = V(std::forward<Args>(args)...);
+                Revive(current_node);
+                return {iterator(this, current_node), expired};
             }
+
+            auto new_node = LinkNewNode(update, std::forward<KK>(key), std::forward<Args>(args)...);
+            return {iterator(this, new_node), true};
         }
-    
-        current = current->links_[0];
-        if(current->key_ == key) {
-            return current->value_;
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare, typename Policy, typename LevelGen>
+    requires SkipNodeArgs<K, V>
+    template<typename KK, typename... Args>
+    requires SkipListKeyComparable<K, KK, Compare> && std::constructible_from<K, KK&&>
+        && std::constructible_from<V, Args&&...>
+    std::pair<typename SkipList<K, V, Compare, Policy, LevelGen>::iterator, bool>
+    SkipList<K, V, Compare, Policy, LevelGen>::TryEmplace(KK&& key, Args&&... args) {
+        if constexpr(ConvertsProbe<std::remove_cvref_t<KK>>) {
+            return TryEmplace(K(std::forward<KK>(key)), std::forward<Args>(args)...);
+        }
+        else {
+            auto [current_node, update] = IdentifyPredecessorNode(key);
+
+            if(Matches(current_node, key)) {
+                //  an expired entry is replaced as if it were not there
+                if(!Expired(current_node)) {
+                    return {iterator(this, current_node), false};
+                }
+                current_node->value_ = V(std::forward<Args>(args)...);
+                Revive(current_node);
+                return {iterator(this, current_node), true};
+            }
+
+            auto new_node = LinkNewNode(update, std::forward<KK>(key), std::forward<Args>(args)...);
+            return {iterator(this, new_node), true};
+        }
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare, typename Policy, typename LevelGen>
+    requires SkipNodeArgs<K, V>
+    template<typename KK, typename M>
+    requires SkipListKeyComparable<K, KK, Compare> && std::constructible_from<K, KK&&>
+        && std::constructible_from<V, M&&> && std::is_assignable_v<V&, M&&>
+    std::pair<typename SkipList<K, V, Compare, Policy, LevelGen>::iterator, bool>
+    SkipList<K, V, Compare, Policy, LevelGen>::InsertOrAssign(KK&& key, M&& value) {
+        if constexpr(ConvertsProbe<std::remove_cvref_t<KK>>) {
+            return InsertOrAssign(K(std::forward<KK>(key)), std::forward<M>(value));
+        }
+        else {
+
+            //  Figure out where to insert the node: This is either the node
+            //  with the same key, so we can update the value, or we found
+            //  the node right before the insertion point so that we can
+            //  insert after it.
+            auto [current_node, update] = IdentifyPredecessorNode(key);
+
+            //  if the key exists at the curent node, update its value
+            if(Matches(current_node, key)) {
+                auto const expired = Expired(current_node);
+                current_node->value_ = std::forward<M>(value);
+                Revive(current_node);
+                return {iterator(this, current_node), expired};
+            }
+
+            //  The key doesn't exist at the current node, insert it
+            //  Update all pointers in the reachability chain to reach this node
+            auto new_node = LinkNewNode(update, std::forward<KK>(key), std::forward<M>(value));
+            return {iterator(this, new_node), true};
+        }
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare, typename Policy, typename LevelGen>
+    requires SkipNodeArgs<K, V>
+    template<typename Q>
+    requires SkipListKeyComparable<K, Q, Compare>
+    std::optional<V>
+    SkipList<K, V, Compare, Policy, LevelGen>::Find(Q const& key) {
+        if(auto node = FindLiveNode(Probe(key)); node != nullptr) {
+            return node->value_;
         }
         else {
             return std::nullopt;
@@ -291,24 +1779,164 @@ namespace pentifica::tbox {
     }
     //  ------------------------------------------------------------------------
     //
-    template<typename K, typename V>
+    template<typename K, typename V, typename Compare, typename Policy, typename LevelGen>
+    requires SkipNodeArgs<K, V>
+    void
+    SkipList<K, V, Compare, Policy, LevelGen>::QueueExpiry([[maybe_unused]] value_type const* node) {
+        if constexpr(Policy::expiring) {
+            if(Expiry(node) != time_point::max()) {
+                expiry_queue_.emplace_back(Expiry(node), node->key_);
+                std::ranges::push_heap(expiry_queue_, ExpiresLater);
+            }
+
+            //  entries refreshed again and again leave stale entries behind;
+            //  rebuilding once they outnumber the keys keeps the queue in
+            //  proportion to the list at an amortized O(1) per entry
+            if(expiry_queue_.size() > 2 * count_ + 64) {
+                expiry_queue_.clear();
+                for(auto current = begin_sentinel_->Link(0); current != end_sentinel_; current = current->Link(0)) {
+                    if(Expiry(current) != time_point::max()) {
+                        expiry_queue_.emplace_back(Expiry(current), current->key_);
+                    }
+                }
+                std::ranges::make_heap(expiry_queue_, ExpiresLater);
+            }
+        }
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare, typename Policy, typename LevelGen>
+    requires SkipNodeArgs<K, V>
+    std::size_t
+    SkipList<K, V, Compare, Policy, LevelGen>::EvictExpired(std::size_t budget, time_point now)
+        requires Policy::expiring {
+        std::size_t evicted{};
+
+        for(; budget > 0 && !expiry_queue_.empty() && expiry_queue_.front().first <= now; --budget) {
+            std::ranges::pop_heap(expiry_queue_, ExpiresLater);
+            auto [expiry, key] = std::move(expiry_queue_.back());
+            expiry_queue_.pop_back();
+
+            //  the entry is current only if the key still expires at its time
+            auto [node, update] = IdentifyPredecessorNode(key);
+            if(Matches(node, key) && Expiry(node) == expiry) {
+                UnlinkNode(update, node);
+                DestroyNode(node);
+                ++evicted;
+            }
+        }
+
+        if(evicted > 0) {
+            ShrinkLevels();
+        }
+        return evicted;
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare, typename Policy, typename LevelGen>
     requires SkipNodeArgs<K, V>
+    template<std::ranges::forward_range Range>
+    std::vector<std::optional<V>>
+    SkipList<K, V, Compare, Policy, LevelGen>::FindInterleaved(Range&& keys) const {
+        using key_iterator = std::ranges::iterator_t<Range>;
+        struct Search {
+            key_iterator key_;
+            std::size_t index_{};
+            value_type* current_{};
+            int level_{};
+            std::size_t hops_{};
+        };
+
+        std::vector<std::optional<V>> found(static_cast<std::size_t>(std::ranges::distance(keys)));
+        std::array<Search, search_group> group;
+        std::size_t active{};
+        std::size_t next_index{};
+        auto next_key = std::ranges::begin(keys);
+        auto const last_key = std::ranges::end(keys);
+
+        //  a search starts at the head, whose links are always cached
+        auto start = [&](Search& search) {
+            search = Search{next_key++, next_index++, begin_sentinel_, top_level_ - 1, 0};
+            Prefetch(begin_sentinel_->Link(search.level_));
+        };
+        for(; active < group.size() && next_key != last_key; ++active) {
+            start(group[active]);
+        }
+
+        while(active > 0) {
+            for(std::size_t i = 0; i < active;) {
+                auto& search = group[i];
+                auto const& key = *search.key_;
+                decltype(auto) probe = Probe(key);
+
+                //  one step: move forward or down. Either way the node the
+                //  search examines next is prefetched, and the other searches
+                //  run while it arrives.
+                auto next = search.current_->Link(search.level_);
+                if(next != end_sentinel_ && Less(next->key_, probe)) {
+                    search.current_ = next;
+                    ++search.hops_;
+                }
+                else if(--search.level_ < 0) {
+                    CountSearch(search.hops_);
+                    if(auto node = search.current_->Link(0); Matches(node, probe) && !Expired(node)) {
+                        found[search.index_].emplace(node->value_);
+                    }
+                    if(next_key != last_key) {
+                        start(search);
+                    }
+                    else {
+                        search = group[--active];
+                        continue;
+                    }
+                }
+                Prefetch(search.current_->Link(search.level_));
+                ++i;
+            }
+        }
+
+        return found;
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare, typename Policy, typename LevelGen>
+    requires SkipNodeArgs<K, V>
+    template<typename Q>
+    SkipListNode<K, V>*
+    SkipList<K, V, Compare, Policy, LevelGen>::FindNode(Q const& key) const {
+        auto current{begin_sentinel_};
+        std::size_t hops{};
+    
+        for(auto search_level = top_level_ - 1; search_level >= 0; search_level--) {
+            for(auto next = NextAt(current, search_level);
+                next != end_sentinel_ && Less(next->key_, key);
+                next = NextAt(current, search_level)) {
+                current = next;
+                ++hops;
+            }
+        }
+    
+        CountSearch(hops);
+        current = current->Link(0);
+        return Matches(current, key) ? current : nullptr;
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare, typename Policy, typename LevelGen>
+    requires SkipNodeArgs<K, V>
+    template<typename Q>
+    requires SkipListKeyComparable<K, Q, Compare>
     SkipListError::ErrorVariant
-    SkipList<K, V>::Delete(K const& key) {
-        auto [node, update] = IdentifyPredecessorNode(key);
+    SkipList<K, V, Compare, Policy, LevelGen>::Delete(Q const& key) {
+        decltype(auto) probe = Probe(key);
+        auto [node, update] = IdentifyPredecessorNode(probe);
     
         //  if the node was found, update all necessary pointers
         //
-        if(node->key_ == key) {
-            for(int i = 0; i < max_level_; i++) {
-                if(update[i]->links_[i] != node) {
-                    break;
-                }
-                update[i]->links_[i] = node->links_[i];
-            }
-    
-            delete node;
-            --count_;
+        if(Matches(node, probe)) {
+            UnlinkNode(update, node);
+            DestroyNode(node);
+            ShrinkLevels();
             return SkipListError::ErrorVariant::NOERR;
         }
     
@@ -0,0 +1,117 @@
+#pragma once
+/// @copyright {2024, Russell J. Fleming. All rights reserved.}
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+#include    <algorithm>
+#include    <cstddef>
+#include    <memory>
+#include    <new>
+#include    <utility>
+#include    <vector>
+
+namespace pentifica::tbox {
+    /// @brief  Node storage for a skip list. Blocks are carved out of large
+    ///         slabs owned by the arena, and released blocks are kept on a free
+    ///         list per size class (the node level) for reuse. All slabs are
+    ///         returned to the heap at once when the arena is released.
+    /// @note   Not thread safe; an arena belongs to a single list.
+    class SkipListArena {
+    public:
+        /// @brief  Default number of bytes in a slab
+        static constexpr std::size_t default_slab_size{64 * 1024};
+        /// @brief  Alignment of every block handed out
+        static constexpr std::size_t block_alignment{alignof(std::max_align_t)};
+
+        /// @brief  Prepare an instance
+        /// @param  slab_size   Number of bytes reserved from the heap at a time
+        explicit SkipListArena(std::size_t slab_size = default_slab_size)
+            : slab_size_(RoundUp(slab_size))
+        {}
+        SkipListArena(SkipListArena const&) = delete;
+        SkipListArena& operator=(SkipListArena const&) = delete;
+        /// @brief  Return all slabs to the heap
+        ~SkipListArena() { Release(); }
+
+        /// @brief  Get a block of storage
+        /// @param  size        Number of bytes required
+        /// @param  size_class  Blocks of the same class have the same size
+        /// @return The block
+        void* Allocate(std::size_t size, int size_class) {
+            if(static_cast<std::size_t>(size_class) < free_lists_.size()
+                && free_lists_[size_class] != nullptr) {
+                auto block = free_lists_[size_class];
+                free_lists_[size_class] = block->next_;
+                return block;
+            }
+
+            size = RoundUp(std::max(size, sizeof(FreeBlock)));
+            if(static_cast<std::size_t>(limit_ - cursor_) < size) {
+                auto reserve = std::max(size, slab_size_);
+                auto slab = static_cast<std::byte*>(
+                    ::operator new(reserve, std::align_val_t{block_alignment}));
+                slabs_.emplace_back(slab, reserve);
+                footprint_ += reserve;
+                cursor_ = slab;
+                limit_ = slab + reserve;
+            }
+
+            auto block = cursor_;
+            cursor_ += size;
+            return block;
+        }
+        /// @brief  Return a block for reuse by blocks of the same size class
+        /// @param  block       The block obtained from Allocate()
+        /// @param  size_class  The size class the block was allocated with
+        void Deallocate(void* block, int size_class) {
+            if(static_cast<std::size_t>(size_class) >= free_lists_.size()) {
+                free_lists_.resize(size_class + 1, nullptr);
+            }
+            free_lists_[size_class] = ::new(block) FreeBlock{free_lists_[size_class]};
+        }
+        /// @brief  Return every slab to the heap. Blocks handed out become invalid.
+        void Release() noexcept {
+            for(auto [slab, size] : slabs_) {
+                ::operator delete(slab, std::align_val_t{block_alignment});
+            }
+            slabs_.clear();
+            free_lists_.clear();
+            footprint_ = 0;
+            cursor_ = limit_ = nullptr;
+        }
+        /// @brief  Returns the number of bytes reserved from the heap
+        /// @return
+        auto Footprint() const noexcept { return footprint_; }
+
+    private:
+        /// @brief  A released block waiting for reuse
+        struct FreeBlock {
+            FreeBlock* next_{};
+        };
+        static constexpr std::size_t RoundUp(std::size_t size) noexcept {
+            return (size + block_alignment - 1) / block_alignment * block_alignment;
+        }
+
+        std::size_t const slab_size_{};
+        std::size_t footprint_{};
+        std::byte* cursor_{};
+        std::byte* limit_{};
+        std::vector<std::pair<std::byte*, std::size_t>> slabs_{};
+        std::vector<FreeBlock*> free_lists_{};
+    };
+}
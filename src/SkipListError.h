@@ -29,6 +29,8 @@ namespace pentifica::tbox {
             BAD_ACCESS,
             ALLOC_FAIL,
             KEY_NOT_FOUND,
+            IO_ERROR,
+            BAD_FORMAT,
             NOERR
         };
 
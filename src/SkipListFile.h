@@ -0,0 +1,349 @@
+#pragma once
+/// @copyright {2024, Russell J. Fleming. All rights reserved.}
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+#include    "SkipList.h"
+#include    "SkipListError.h"
+
+#include    <algorithm>
+#include    <bit>
+#include    <cstddef>
+#include    <cstdint>
+#include    <cstring>
+#include    <filesystem>
+#include    <fstream>
+#include    <functional>
+#include    <optional>
+#include    <ranges>
+#include    <span>
+#include    <string_view>
+#include    <system_error>
+#include    <type_traits>
+#include    <utility>
+
+#include    <fcntl.h>
+#include    <sys/mman.h>
+#include    <sys/stat.h>
+#include    <unistd.h>
+
+namespace pentifica::tbox {
+    /// @brief  Keys and values that can be stored in a skip list file: they
+    ///         are written and mapped back as raw bytes
+    template<typename K, typename V>
+    concept SkipListFileArgs = std::is_trivially_copyable_v<K> && std::is_trivially_copyable_v<V>
+        && alignof(K) <= 64 && alignof(V) <= 64;
+
+    /// @brief  Layout of a skip list file. The header is followed by the keys
+    ///         of every entry in list order, then by the values in the same
+    ///         order. Both arrays start on a 64 byte boundary, so a mapped
+    ///         file can be read in place.
+    struct SkipListFileHeader {
+        static constexpr char file_magic[8]{'T', 'B', 'S', 'K', 'I', 'P', 'L', '\0'};
+        static constexpr std::uint32_t file_version{1};
+        static constexpr std::uint32_t file_byte_order{0x01020304};
+        static constexpr std::uint64_t section_alignment{64};
+
+        char magic[8]{};
+        /// @brief  Written as file_byte_order; files from a machine of the
+        ///         other endianness are rejected
+        std::uint32_t byte_order{};
+        std::uint32_t version{};
+        std::uint32_t key_size{};
+        std::uint32_t value_size{};
+        std::uint64_t count{};
+        std::uint64_t keys_offset{};
+        std::uint64_t values_offset{};
+
+        /// @brief  Prepare the header of a file holding count entries
+        static SkipListFileHeader For(std::uint64_t count, std::uint32_t key_size, std::uint32_t value_size) {
+            SkipListFileHeader header{};
+            std::memcpy(header.magic, file_magic, sizeof(magic));
+            header.byte_order = file_byte_order;
+            header.version = file_version;
+            header.key_size = key_size;
+            header.value_size = value_size;
+            header.count = count;
+            header.keys_offset = Align(sizeof(SkipListFileHeader));
+            header.values_offset = Align(header.keys_offset + count * key_size);
+            return header;
+        }
+        /// @brief  Returns true if the header describes a file of the given
+        ///         size holding the given key and value types
+        bool Valid(std::uint64_t file_size, std::uint32_t expected_key_size,
+                std::uint32_t expected_value_size) const {
+            return std::memcmp(magic, file_magic, sizeof(magic)) == 0
+                && byte_order == file_byte_order
+                && version == file_version
+                && key_size == expected_key_size
+                && value_size == expected_value_size
+                && keys_offset % section_alignment == 0
+                && values_offset % section_alignment == 0
+                && keys_offset >= sizeof(SkipListFileHeader)
+                && count <= (file_size - std::min(file_size, keys_offset)) / std::max(key_size, 1u)
+                && values_offset >= keys_offset + count * key_size
+                && values_offset <= file_size
+                && count <= (file_size - values_offset) / std::max(value_size, 1u);
+        }
+        static constexpr std::uint64_t Align(std::uint64_t offset) noexcept {
+            return (offset + section_alignment - 1) / section_alignment * section_alignment;
+        }
+    };
+
+    /// @brief  Write a skip list to a file. The file is written next to its
+    ///         final path and renamed into place, so a reader never sees a
+    ///         partially written file.
+    /// @param  list    The list to save
+    /// @param  path    The file to create or replace
+    /// @return NOERR, or IO_ERROR if the file could not be written
+    template<typename K, typename V, typename Compare, typename Policy, typename LevelGen>
+    requires SkipListFileArgs<K, V>
+    SkipListError::ErrorVariant
+    SaveSkipList(SkipList<K, V, Compare, Policy, LevelGen> const& list, std::filesystem::path const& path) {
+        auto const header = SkipListFileHeader::For(list.Size(), sizeof(K), sizeof(V));
+        auto temporary = path;
+        temporary += ".tmp";
+
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            auto pad_to = [&file](std::uint64_t offset) {
+                static constexpr char zeros[SkipListFileHeader::section_alignment]{};
+                file.write(zeros, static_cast<std::streamsize>(offset - static_cast<std::uint64_t>(file.tellp())));
+            };
+
+            file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+            pad_to(header.keys_offset);
+            for(auto const& node : list) {
+                file.write(reinterpret_cast<char const*>(&node.Key()), sizeof(K));
+            }
+            pad_to(header.values_offset);
+            for(auto const& node : list) {
+                file.write(reinterpret_cast<char const*>(&node.Value()), sizeof(V));
+            }
+            file.flush();
+            if(!file) {
+                std::error_code ignored;
+                std::filesystem::remove(temporary, ignored);
+                return SkipListError::ErrorVariant::IO_ERROR;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temporary, path, error);
+        if(error) {
+            std::filesystem::remove(temporary, error);
+            return SkipListError::ErrorVariant::IO_ERROR;
+        }
+        return SkipListError::ErrorVariant::NOERR;
+    }
+
+    /// @brief  Read-only view of a skip list file mapped into memory. Lookups
+    ///         binary search the mapped keys in place; nothing is copied or
+    ///         allocated, and pages are read from the file on first use.
+    /// @tparam K   The key type
+    /// @tparam V   The value type
+    /// @tparam Compare The ordering the list was saved with
+    template<typename K, typename V, typename Compare = std::less<K>>
+    requires SkipListFileArgs<K, V>
+    class SkipListFileView {
+    public:
+        /// @brief  Prepare an instance with no file open
+        /// @param  compare The ordering the list was saved with
+        explicit SkipListFileView(Compare compare = Compare{}) : compare_(std::move(compare)) {}
+        SkipListFileView(SkipListFileView const&) = delete;
+        SkipListFileView& operator=(SkipListFileView const&) = delete;
+        SkipListFileView(SkipListFileView&& other) noexcept
+            : mapping_(std::exchange(other.mapping_, nullptr))
+            , mapping_size_(std::exchange(other.mapping_size_, 0))
+            , keys_(std::exchange(other.keys_, {}))
+            , values_(std::exchange(other.values_, {}))
+            , compare_(std::move(other.compare_))
+        {}
+        SkipListFileView& operator=(SkipListFileView&& other) noexcept {
+            if(this != &other) {
+                Close();
+                mapping_ = std::exchange(other.mapping_, nullptr);
+                mapping_size_ = std::exchange(other.mapping_size_, 0);
+                keys_ = std::exchange(other.keys_, {});
+                values_ = std::exchange(other.values_, {});
+                compare_ = std::move(other.compare_);
+            }
+            return *this;
+        }
+        /// @brief  Unmap the file
+        ~SkipListFileView() { Close(); }
+
+        /// @brief  Map a file written by SaveSkipList, replacing any file
+        ///         already open
+        /// @param  path    The file to map
+        /// @return NOERR, IO_ERROR if the file cannot be opened or mapped, or
+        ///         BAD_FORMAT if it does not hold a list of K and V
+        SkipListError::ErrorVariant Open(std::filesystem::path const& path);
+
+        /// @brief  Unmap the file, if one is open
+        void Close() noexcept {
+            if(mapping_ != nullptr) {
+                ::munmap(mapping_, mapping_size_);
+            }
+            mapping_ = nullptr;
+            mapping_size_ = 0;
+            keys_ = {};
+            values_ = {};
+        }
+
+        /// @brief  Returns the number of entries in the file
+        /// @return
+        auto Size() const noexcept { return keys_.size(); }
+        /// @brief  Returns true if there are no entries
+        /// @return
+        bool Empty() const noexcept { return keys_.empty(); }
+        /// @brief  Returns the keys, in list order
+        /// @return
+        std::span<K const> Keys() const noexcept { return keys_; }
+        /// @brief  Returns the values, in the order of their keys
+        /// @return
+        std::span<V const> Values() const noexcept { return values_; }
+        /// @brief  Returns the entries as a range of key-value pairs, in list
+        ///         order, suitable for SkipList::BulkLoad
+        /// @return
+        auto Entries() const {
+            return std::views::iota(std::size_t{}, Size())
+                | std::views::transform([this](std::size_t index) {
+                    return std::pair<K const&, V const&>(keys_[index], values_[index]);
+                });
+        }
+
+        /// @brief  Returns the position of the first key not ordered before key
+        /// @param  key     The lookup key, or any probe comparable with K
+        /// @return The position, Size() if there is no such key
+        template<typename Q = K>
+        requires SkipListKeyComparable<K, Q, Compare>
+        std::size_t LowerBound(Q const& key) const {
+            auto found = std::lower_bound(keys_.begin(), keys_.end(), key, compare_);
+            return static_cast<std::size_t>(found - keys_.begin());
+        }
+
+        /// @brief  Get the value associated with a particular key
+        /// @param  key     The lookup key, or any probe comparable with K
+        /// @return An optional value referencing the value associated with the key
+        template<typename Q = K>
+        requires SkipListKeyComparable<K, Q, Compare>
+        std::optional<V> Find(Q const& key) const {
+            auto index = LowerBound(key);
+            if(index == Size() || compare_(key, keys_[index])) {
+                return std::nullopt;
+            }
+            return values_[index];
+        }
+
+        /// @brief  Visit, in key order, every entry with a key in [first, last)
+        /// @param  first   The first key of the range
+        /// @param  last    The key ending the range (not visited)
+        /// @param  visitor Invoked with each key and value. If it returns a
+        ///                 bool, the scan stops when it returns false.
+        /// @return The number of entries visited
+        template<typename Visitor>
+        std::size_t ForEachInRange(K const& first, K const& last, Visitor&& visitor) const {
+            std::size_t visited{};
+
+            for(auto index = LowerBound(first); index < Size() && compare_(keys_[index], last); ++index) {
+                ++visited;
+                if constexpr(std::is_convertible_v<std::invoke_result_t<Visitor&, K const&, V const&>, bool>) {
+                    if(!std::invoke(visitor, keys_[index], values_[index])) break;
+                }
+                else {
+                    std::invoke(visitor, keys_[index], values_[index]);
+                }
+            }
+
+            return visited;
+        }
+
+    private:
+        void* mapping_{};
+        std::size_t mapping_size_{};
+        std::span<K const> keys_{};
+        std::span<V const> values_{};
+        [[no_unique_address]] Compare compare_;
+    };
+
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare>
+    requires SkipListFileArgs<K, V>
+    SkipListError::ErrorVariant
+    SkipListFileView<K, V, Compare>::Open(std::filesystem::path const& path) {
+        Close();
+
+        auto descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if(descriptor < 0) {
+            return SkipListError::ErrorVariant::IO_ERROR;
+        }
+
+        struct stat status{};
+        if(::fstat(descriptor, &status) != 0) {
+            ::close(descriptor);
+            return SkipListError::ErrorVariant::IO_ERROR;
+        }
+        auto const file_size = static_cast<std::uint64_t>(status.st_size);
+        if(file_size < sizeof(SkipListFileHeader)) {
+            ::close(descriptor);
+            return SkipListError::ErrorVariant::BAD_FORMAT;
+        }
+
+        //  the mapping stays valid once the descriptor is closed
+        auto mapping = ::mmap(nullptr, file_size, PROT_READ, MAP_SHARED, descriptor, 0);
+        ::close(descriptor);
+        if(mapping == MAP_FAILED) {
+            return SkipListError::ErrorVariant::IO_ERROR;
+        }
+
+        SkipListFileHeader header;
+        std::memcpy(&header, mapping, sizeof(header));
+        if(!header.Valid(file_size, sizeof(K), sizeof(V))) {
+            ::munmap(mapping, file_size);
+            return SkipListError::ErrorVariant::BAD_FORMAT;
+        }
+
+        auto base = static_cast<std::byte const*>(mapping);
+        mapping_ = mapping;
+        mapping_size_ = file_size;
+        keys_ = {std::launder(reinterpret_cast<K const*>(base + header.keys_offset)), header.count};
+        values_ = {std::launder(reinterpret_cast<V const*>(base + header.values_offset)), header.count};
+        return SkipListError::ErrorVariant::NOERR;
+    }
+    //  ------------------------------------------------------------------------
+    //
+    /// @brief  Add the entries of a file written by SaveSkipList to a list.
+    ///         An empty list is rebuilt with BulkLoad straight from the mapped
+    ///         file; otherwise the entries are inserted.
+    /// @param  list    The list to load
+    /// @param  path    The file to read
+    /// @return NOERR, or the error reported by SkipListFileView::Open
+    template<typename K, typename V, typename Compare, typename Policy, typename LevelGen>
+    requires SkipListFileArgs<K, V>
+    SkipListError::ErrorVariant
+    LoadSkipList(SkipList<K, V, Compare, Policy, LevelGen>& list, std::filesystem::path const& path) {
+        SkipListFileView<K, V, Compare> view(list.GetCompare());
+        if(auto error = view.Open(path); error != SkipListError::ErrorVariant::NOERR) {
+            return error;
+        }
+        list.BulkLoad(view.Entries());
+        return SkipListError::ErrorVariant::NOERR;
+    }
+}
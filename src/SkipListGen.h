@@ -18,31 +18,102 @@
 /// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 /// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 /// SOFTWARE.
+#include    <algorithm>
+#include    <bit>
+#include    <cstdint>
 #include    <random>
 #include    <functional>
 #include    <ctime>
 
 namespace pentifica::tbox{
+    /// @brief  Seed used by a generator when none is given
+    /// @return A seed that differs from run to run
+    inline std::uint64_t SkipListRandomSeed() {
+        return (static_cast<std::uint64_t>(std::random_device{}()) << 32)
+            ^ static_cast<std::uint64_t>(std::time(nullptr));
+    }
+
+    /// @brief  Level generator drawing from a std::mt19937. Given the same
+    ///         seed, it produces the same levels on every platform, so lists
+    ///         built by the same operations have the same layout.
     class SkipListLevelGenerator {
     public:
+        /// @brief  Prepare an instance seeded differently on each run
+        /// @param  p_factor    Probability of promoting a node another level
         SkipListLevelGenerator(double p_factor) :
-            p_(p_factor)
+            SkipListLevelGenerator(p_factor, SkipListRandomSeed())
+        {
+        }
+        /// @brief  Prepare an instance producing a reproducible sequence
+        /// @param  p_factor    Probability of promoting a node another level
+        /// @param  seed        The seed for the sequence
+        SkipListLevelGenerator(double p_factor, std::uint64_t seed) :
+            threshold_(Threshold(p_factor))
         {
+            Seed(seed);
+        }
+        /// @brief  Restart the sequence from a seed
+        /// @param  seed    The seed for the sequence
+        void Seed(std::uint64_t seed) {
+            std::seed_seq sequence{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)};
+            rng_.seed(sequence);
         }
         /// @brief  Generate the next value within the range 0 .. max_level-1
         /// @param max_level    The upper bound for the generated level
         /// @return The generated value
         int operator()(int max_level) {
+            //  compare raw engine output with a threshold: unlike a
+            //  uniform_real_distribution, the engine's output is fully
+            //  specified by the standard
             int level{1};
-            while((level < max_level) && (distribution_(rng_) < p_)) {
+            while((level < max_level) && (rng_() < threshold_)) {
                 ++level;
             }
             return level - 1;
         }
     private:
-        double const p_{};
-        std::mt19937 rng_{std::mt19937(std::time(nullptr))};
-        std::uniform_real_distribution<double>
-            distribution_{std::uniform_real_distribution<double>(0.0, 1.0)};
+        /// @brief  Returns the engine output below which a node is promoted
+        static std::uint64_t Threshold(double p_factor) {
+            constexpr double range = static_cast<double>(std::mt19937::max()) + 1.0;
+            return static_cast<std::uint64_t>(std::clamp(p_factor, 0.0, 1.0) * range);
+        }
+
+        std::uint64_t const threshold_{};
+        std::mt19937 rng_{};
+    };
+    /// @brief  Level generator costing one 64-bit draw per node (per call).
+    ///         Each trailing zero bit of a splitmix64 draw promotes the node
+    ///         one level, so a node reaches level l with probability p^l where
+    ///         p = 1/2^Shift. The state is a single word, so the generator is
+    ///         cheap to copy and its call inlines into SkipList::Insert when it
+    ///         is named as the list's LevelGen.
+    /// @tparam Shift   Number of zero bits needed per level (1: p = 1/2, 2: p = 1/4)
+    template<int Shift = 1>
+    requires (Shift > 0 && Shift < 64)
+    class SkipListFastLevelGenerator {
+    public:
+        /// @brief  Prepare an instance seeded differently on each run
+        SkipListFastLevelGenerator() : state_(SkipListRandomSeed()) {}
+        /// @brief  Prepare an instance producing a reproducible sequence
+        /// @param  seed    The seed for the sequence
+        explicit SkipListFastLevelGenerator(std::uint64_t seed) noexcept : state_(seed) {}
+        /// @brief  Restart the sequence from a seed
+        /// @param  seed    The seed for the sequence
+        void Seed(std::uint64_t seed) noexcept { state_ = seed; }
+        /// @brief  Generate the next value within the range 0 .. max_level-1
+        /// @param max_level    The upper bound for the generated level
+        /// @return The generated value
+        int operator()(int max_level) noexcept {
+            return std::min(std::countr_zero(Next()) / Shift, max_level - 1);
+        }
+    private:
+        /// @brief  Returns the next splitmix64 draw
+        std::uint64_t Next() noexcept {
+            auto z = (state_ += 0x9e3779b97f4a7c15ull);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+            return z ^ (z >> 31);
+        }
+        std::uint64_t state_{};
     };
 }
@@ -20,9 +20,15 @@
 /// SOFTWARE.
 ///
 /// This code is based on the article https://rowjee.com/blog/skiplists
-#include    <vector>
 #include    <concepts>
+#include    <cstddef>
+#include    <functional>
+#include    <memory>
+#include    <new>
+#include    <span>
+#include    <algorithm>
 #include    <type_traits>
+#include    <utility>
 
 namespace pentifica::tbox {
     template<typename K, typename V>
@@ -33,49 +39,104 @@ namespace pentifica::tbox {
         requires std::is_default_constructible_v<V>;
     };
 
+    /// @brief  A probe of type Q can be used to search for keys of type K
+    ///         ordered by Compare
+    template<typename K, typename Q, typename Compare = std::less<K>>
+    concept SkipListKeyComparable = requires(Compare const& compare, K const& key, Q const& probe) {
+        { compare(key, probe) } -> std::convertible_to<bool>;
+        { compare(probe, key) } -> std::convertible_to<bool>;
+    };
+
+    /// @brief  The most levels a skip list can have. 32 levels index 2^32
+    ///         nodes with p = 1/2.
+    inline constexpr int skip_list_level_limit{32};
+
     //  forward declarations
-    template<typename K, typename V>
+    template<typename K, typename V, typename Compare, typename Policy, typename LevelGen>
     requires SkipNodeArgs<K, V>
     class SkipList;
+    template<typename SL>
+    class SkipListIterator;
 
-    /// @brief  Node representative in the skip list
+    /// @brief  Node representative in the skip list. The forward links are
+    ///         stored in the same allocation, directly after the node, so a
+    ///         node is created with Create() and released with Destroy().
     /// @tparam K   The key type
     /// @tparam V   The value type  
     template<typename K, typename V>
     requires SkipNodeArgs<K, V>
     class SkipListNode {
     public:
-        friend class SkipList<K, V>;
-        friend typename SkipList<K, V>::iterator;
-        friend typename SkipList<K, V>::const_iterator;
+        template<typename K2, typename V2, typename Compare, typename Policy, typename LevelGen>
+        requires SkipNodeArgs<K2, V2>
+        friend class SkipList;
+        template<typename SL>
+        friend class SkipListIterator;
         
         using key_type = K;
         using value_type = V;
-        SkipListNode() = default;
-        SkipListNode(SkipListNode const&) = default;
-        SkipListNode(SkipListNode&&) = default;
-        /// @brief  Prepare an instance for use
+        SkipListNode(SkipListNode const&) = delete;
+        SkipListNode(SkipListNode&&) = delete;
+        SkipListNode& operator=(SkipListNode const& other) = delete;
+        SkipListNode& operator=(SkipListNode&& other) = delete;
+        /// @brief  Returns the number of bytes needed for a node and its links
+        /// @param  current_level   The level for the node (node level is zero-based)
+        /// @return 
+        static constexpr std::size_t AllocationSize(int current_level) noexcept {
+            return LinksOffset() + (current_level + 1) * sizeof(SkipListNode*);
+        }
+        /// @brief  Returns the alignment of the storage for a node and its links
+        /// @return
+        static constexpr std::size_t Alignment() noexcept {
+            return std::max(alignof(SkipListNode), alignof(SkipListNode*));
+        }
+        /// @brief  Allocate and prepare an instance for use
         /// @param  current_level   The level for the node (node level is zero-based)
         /// @param  key The node identifier
         /// @param  value   The node's value
-        SkipListNode(int current_level, K key, V value)
-            : current_level_(current_level)
-            , key_(std::move(key))
-            , value_(std::move(value))
-            , links_(current_level + 1, nullptr)
-        {
+        /// @return The new node
+        static SkipListNode* Create(int current_level, K key, V value) {
+            auto storage = ::operator new(AllocationSize(current_level),
+                std::align_val_t{Alignment()});
+            return Create(storage, current_level, std::move(key), std::move(value));
+        }
+        /// @brief  Prepare an instance for use in caller supplied storage
+        /// @param  storage The storage for the node (see AllocationSize, Alignment)
+        /// @param  current_level   The level for the node (node level is zero-based)
+        /// @param  key The node identifier
+        /// @param  value   The node's value
+        /// @return The new node
+        static SkipListNode* Create(void* storage, int current_level, K key, V value) {
+            return ::new(storage) SkipListNode(current_level, std::move(key), std::move(value));
+        }
+        /// @brief  Prepare an instance for use in caller supplied storage,
+        ///         constructing the key and value in place
+        /// @param  storage The storage for the node (see AllocationSize, Alignment)
+        /// @param  current_level   The level for the node (node level is zero-based)
+        /// @param  key The argument for constructing the node identifier
+        /// @param  args    The arguments for constructing the node's value
+        /// @return The new node
+        template<typename KK, typename... Args>
+        requires std::constructible_from<K, KK&&> && std::constructible_from<V, Args&&...>
+        static SkipListNode* Emplace(void* storage, int current_level, KK&& key, Args&&... args) {
+            return ::new(storage) SkipListNode(current_level, std::in_place,
+                std::forward<KK>(key), std::forward<Args>(args)...);
+        }
+        /// @brief  Release a node obtained from the allocating Create()
+        /// @param  node    The node to release
+        static void Destroy(SkipListNode* node) noexcept {
+            node->~SkipListNode();
+            ::operator delete(node, std::align_val_t{Alignment()});
         }
         bool operator==(SkipListNode const& other) const {
             return key_ == other.key_
                 && value_ == other.value_
                 && current_level_ == other.current_level_
-                && links_ == other.links_;
+                && std::ranges::equal(Links(), other.Links());
         }
         bool operator!=(SkipListNode const& other) const {
             return !operator==(other);
         }
-        SkipListNode& operator=(SkipListNode const& other) = default;
-        SkipListNode& operator=(SkipListNode&& other) = default;
         /// @brief Returns the level this node was added to the skip list aat
         /// @return     
         auto Level() const noexcept { return current_level_; }
@@ -90,16 +151,47 @@ namespace pentifica::tbox {
         auto const& Value() const noexcept { return value_; }
         /// @brief  The links to the next nodes at level are returned
         /// @return
-        auto const& Links() const noexcept { return links_; }
+        std::span<SkipListNode* const> Links() const noexcept {
+            return {LinksData(), static_cast<std::size_t>(current_level_ + 1)};
+        }
 
     private:
+        /// @brief  Prepare an instance for use. The storage must have room
+        ///         for the links (see AllocationSize).
+        SkipListNode(int current_level, K key, V value)
+            : current_level_(current_level)
+            , key_(std::move(key))
+            , value_(std::move(value))
+        {
+            std::uninitialized_value_construct_n(LinksData(), current_level + 1);
+        }
+        template<typename KK, typename... Args>
+        SkipListNode(int current_level, std::in_place_t, KK&& key, Args&&... args)
+            : current_level_(current_level)
+            , key_(std::forward<KK>(key))
+            , value_(std::forward<Args>(args)...)
+        {
+            std::uninitialized_value_construct_n(LinksData(), current_level + 1);
+        }
+        /// @brief  Offset from the start of the node to its links
+        static constexpr std::size_t LinksOffset() noexcept {
+            return (sizeof(SkipListNode) + alignof(SkipListNode*) - 1)
+                / alignof(SkipListNode*) * alignof(SkipListNode*);
+        }
+        /// @brief  Returns the start of the links stored after the node
+        SkipListNode** LinksData() const noexcept {
+            return std::launder(reinterpret_cast<SkipListNode**>(
+                reinterpret_cast<std::byte*>(const_cast<SkipListNode*>(this)) + LinksOffset()));
+        }
+        /// @brief  Returns the link to the next node at a level
+        /// @param  level   The level of the link
+        SkipListNode*& Link(int level) const noexcept { return LinksData()[level]; }
+
         /// @brief  The level the node was added to the dkip list
         int const current_level_{};
         /// @brief  The key associated with the node
         key_type const key_{};
         /// @brief  The value associated with the node
         value_type value_{};
-        /// @brief  Links to the next nodes in the skip list levels
-        std::vector<SkipListNode*> links_;
     };
 }
\ No newline at end of file
@@ -0,0 +1,538 @@
+#pragma once
+/// @copyright {2024, Russell J. Fleming. All rights reserved.}
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+/// This code is based on:
+///     The LevelDB/RocksDB memtable: a skip list of (key, sequence) entries
+///     with one writer at a time and lock-free readers
+#include    "SkipListNode.h"
+#include    "SkipListError.h"
+#include    "ConcurrentSkipList.h"
+
+#include    <algorithm>
+#include    <array>
+#include    <atomic>
+#include    <cstdint>
+#include    <functional>
+#include    <iterator>
+#include    <mutex>
+#include    <optional>
+#include    <ranges>
+#include    <set>
+#include    <utility>
+#include    <vector>
+
+namespace pentifica::tbox {
+    /// @brief  A multi-version skip list. A write never changes an entry in
+    ///         place: it appends a new version of the key (a tombstone for a
+    ///         delete) stamped with the next sequence number. A Snapshot
+    ///         pins a sequence number and sees every key as it was then, so
+    ///         long ordered scans run alongside writers without blocking them
+    ///         or seeing their changes. Versions no snapshot can see any more
+    ///         are removed by Collect().
+    ///
+    ///         Writers take a mutex, one at a time. Readers take no lock:
+    ///         links are published with release stores, and removed versions
+    ///         are reclaimed once no reader can still be stepping through
+    ///         them (epoch based reclamation, as in ConcurrentSkipList).
+    /// @note   Snapshots must be released before the list is destroyed.
+    /// @tparam K   The key type
+    /// @tparam V   The value type
+    /// @tparam Compare Orders the keys
+    template<typename K, typename V, typename Compare = std::less<K>>
+    requires SkipNodeArgs<K, V>
+    class VersionedSkipList {
+    public:
+        /// @brief  One version of a key. It never changes once published.
+        class Version {
+        public:
+            Version(int top_level, std::uint64_t sequence, bool tombstone, K key, V value)
+                : key_(std::move(key))
+                , value_(std::move(value))
+                , sequence_(sequence)
+                , top_level_(top_level)
+                , tombstone_(tombstone)
+                , links_(top_level + 1)
+            {}
+            /// @brief  The key is returned
+            K const& Key() const noexcept { return key_; }
+            /// @brief  The value is returned
+            V const& Value() const noexcept { return value_; }
+            /// @brief  The sequence number of the write that made this version
+            std::uint64_t Sequence() const noexcept { return sequence_; }
+
+        private:
+            friend class VersionedSkipList;
+
+            K const key_{};
+            V const value_{};
+            std::uint64_t const sequence_{};
+            int const top_level_{};
+            bool const tombstone_{};
+            std::vector<std::atomic<Version*>> links_;
+        };
+
+        class Snapshot;
+
+        /// @brief  Iterates the keys visible to a snapshot in key order,
+        ///         yielding the version of each key the snapshot sees
+        class Iterator {
+        public:
+            using iterator_concept = std::forward_iterator_tag;
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Version;
+            using difference_type = std::ptrdiff_t;
+            using reference = Version const&;
+            using pointer = Version const*;
+
+            Iterator() noexcept = default;
+            Iterator& operator++() {
+                auto guard = list_->epoch_.Pin();
+                version_ = list_->SeekVisible(list_->NextKey(version_), sequence_);
+                return *this;
+            }
+            Iterator operator++(int) {
+                auto temp{*this};
+                ++(*this);
+                return temp;
+            }
+            friend bool operator==(Iterator const& lhs, Iterator const& rhs) noexcept {
+                return lhs.version_ == rhs.version_;
+            }
+            reference operator*() const noexcept { return *version_; }
+            pointer operator->() const noexcept { return version_; }
+
+        private:
+            friend class VersionedSkipList;
+
+            Iterator(VersionedSkipList const* list, Version* version, std::uint64_t sequence) noexcept
+                : list_(list)
+                , version_(version)
+                , sequence_(sequence)
+            {}
+
+            VersionedSkipList const* list_{};
+            Version* version_{};
+            std::uint64_t sequence_{};
+        };
+
+        /// @brief  A consistent, point-in-time view of the list. The versions
+        ///         it sees stay in place until it is released.
+        class Snapshot {
+        public:
+            Snapshot(Snapshot&& other) noexcept
+                : list_(std::exchange(other.list_, nullptr))
+                , sequence_(other.sequence_)
+            {}
+            Snapshot(Snapshot const&) = delete;
+            Snapshot& operator=(Snapshot const&) = delete;
+            Snapshot& operator=(Snapshot&&) = delete;
+            /// @brief  Release the snapshot, letting Collect remove the
+            ///         versions only it could see
+            ~Snapshot() {
+                if(list_ != nullptr) list_->ReleaseSnapshot(sequence_);
+            }
+            /// @brief  The sequence number of the last write the snapshot sees
+            std::uint64_t Sequence() const noexcept { return sequence_; }
+            /// @brief  Get the value a key had when the snapshot was taken
+            /// @param  key     The lookup key
+            /// @return The value, nullopt if the key did not exist
+            std::optional<V> Find(K const& key) const {
+                auto value = Lookup(key);
+                return value != nullptr ? std::optional<V>(*value) : std::nullopt;
+            }
+            /// @brief  Get the value a key had when the snapshot was taken,
+            ///         without copying it
+            /// @return The address of the value, valid for the life of the
+            ///         snapshot; nullptr if the key did not exist
+            V const* Lookup(K const& key) const {
+                //  the descent steps through versions of other keys that
+                //  Collect may retire; only the one found is the snapshot's
+                auto guard = list_->epoch_.Pin();
+                auto version = list_->FindVersion(key, sequence_);
+                return version != nullptr ? &version->value_ : nullptr;
+            }
+            /// @brief  Returns an iterator to the first key not less than key
+            Iterator LowerBound(K const& key) const {
+                auto guard = list_->epoch_.Pin();
+                return Iterator(list_, list_->SeekVisible(list_->Seek(key, sequence_), sequence_), sequence_);
+            }
+            /// @brief  Visit, in key order, every version the snapshot sees
+            ///         with a key in [first, last)
+            /// @param  visitor Invoked with each Version. If it returns a
+            ///                 bool, the scan stops when it returns false.
+            /// @return The number of versions visited
+            template<typename Visitor>
+            std::size_t ForEachInRange(K const& first, K const& last, Visitor&& visitor) const {
+                std::size_t visited{};
+                for(auto it = LowerBound(first); it != end() && list_->compare_(it->Key(), last); ++it) {
+                    ++visited;
+                    if constexpr(std::is_convertible_v<std::invoke_result_t<Visitor&, Version const&>, bool>) {
+                        if(!std::invoke(visitor, *it)) break;
+                    }
+                    else {
+                        std::invoke(visitor, *it);
+                    }
+                }
+                return visited;
+            }
+            Iterator begin() const {
+                auto guard = list_->epoch_.Pin();
+                return Iterator(list_, list_->SeekVisible(list_->First(), sequence_), sequence_);
+            }
+            Iterator end() const { return Iterator(list_, list_->end_sentinel_, sequence_); }
+
+        private:
+            friend class VersionedSkipList;
+
+            Snapshot(VersionedSkipList const* list, std::uint64_t sequence) noexcept
+                : list_(list)
+                , sequence_(sequence)
+            {}
+
+            VersionedSkipList const* list_{};
+            std::uint64_t sequence_{};
+        };
+
+        /// @brief  Basic setup of an instance
+        /// @param  max_level   Number of levels in the skiplist
+        /// @param  gen_next_skip_level  Generates a skip level (0 .. max_level - 1).
+        ///                     Writers are serialized, so it need not be thread safe.
+        /// @param  compare     Orders the keys
+        VersionedSkipList(int max_level, std::function<int(int)> gen_next_skip_level, Compare compare = Compare{});
+        VersionedSkipList(VersionedSkipList const&) = delete;
+        VersionedSkipList& operator=(VersionedSkipList const&) = delete;
+        /// @brief  Instance cleanup. No operation may be in flight and no
+        ///         snapshot may be held.
+        ~VersionedSkipList();
+
+        /// @brief  Write a new version of a key
+        /// @param  key
+        /// @param  value
+        /// @return The sequence number of the write
+        std::uint64_t Put(K const& key, V const& value) {
+            std::lock_guard lock(writer_mutex_);
+            Append(key, value, false);
+            return Publish();
+        }
+        /// @brief  Write a new version of several keys as one write: a
+        ///         snapshot sees all of them or none
+        /// @param  entries The (key, value) pairs to write. A key written
+        ///                 twice keeps the later value.
+        /// @return The sequence number of the last write in the batch
+        template<std::ranges::input_range R>
+        requires std::convertible_to<std::ranges::range_reference_t<R>, std::pair<K, V>>
+        std::uint64_t PutBatch(R&& entries) {
+            std::lock_guard lock(writer_mutex_);
+            for(auto&& entry : entries) {
+                std::pair<K, V> const& pair = entry;
+                Append(pair.first, pair.second, false);
+            }
+            return Publish();
+        }
+        /// @brief  Delete a key by writing a tombstone version of it
+        /// @param  key     The key to delete
+        /// @return NOERR, or KEY_NOT_FOUND if the key does not currently exist
+        SkipListError::ErrorVariant Delete(K const& key) {
+            std::lock_guard lock(writer_mutex_);
+            if(FindVersion(key, last_sequence_.load(std::memory_order_relaxed)) == nullptr) {
+                return SkipListError::ErrorVariant::KEY_NOT_FOUND;
+            }
+            Append(key, V{}, true);
+            Publish();
+            return SkipListError::ErrorVariant::NOERR;
+        }
+        /// @brief  Get a copy of the latest value of a key
+        /// @param  key     The lookup key
+        /// @return The value, nullopt if the key does not exist
+        std::optional<V> Find(K const& key) const {
+            //  the sequence is not registered, so a write published during
+            //  the search may be followed by a Collect removing the version
+            //  it is looking for. The result stands only if no write was
+            //  published meanwhile; under a stream of writes the lookup
+            //  falls back to a snapshot, which Collect respects.
+            {
+                auto guard = epoch_.Pin();
+                for(int attempt = 0; attempt < find_attempts; ++attempt) {
+                    auto const sequence = last_sequence_.load(std::memory_order_acquire);
+                    auto version = FindVersion(key, sequence);
+                    if(last_sequence_.load(std::memory_order_acquire) == sequence) {
+                        return version != nullptr ? std::optional<V>(version->value_) : std::nullopt;
+                    }
+                }
+            }
+            return TakeSnapshot().Find(key);
+        }
+
+        /// @brief  Take a snapshot of the list as of the last completed write
+        /// @return The snapshot; it must be released before the list is destroyed
+        Snapshot TakeSnapshot() const {
+            std::lock_guard lock(snapshot_mutex_);
+            auto const sequence = last_sequence_.load(std::memory_order_acquire);
+            snapshots_.insert(sequence);
+            return Snapshot(this, sequence);
+        }
+
+        /// @brief  Remove the versions no snapshot can see: every version of
+        ///         a key older than the newest one visible to the oldest
+        ///         snapshot, and that version too if it is a tombstone.
+        ///         Walks the whole list and holds the writer lock; readers
+        ///         are not blocked.
+        /// @return The number of versions removed
+        std::size_t Collect();
+
+        /// @brief  Returns the number of versions held, tombstones included
+        auto Versions() const noexcept { return versions_.load(std::memory_order_relaxed); }
+        /// @brief  Returns the sequence number of the last completed write
+        auto Sequence() const noexcept { return last_sequence_.load(std::memory_order_acquire); }
+        /// @brief  Returns the number of snapshots held
+        std::size_t Snapshots() const {
+            std::lock_guard lock(snapshot_mutex_);
+            return snapshots_.size();
+        }
+
+    private:
+        /// @brief  Number of unregistered searches Find makes before it
+        ///         reads through a snapshot
+        static constexpr int find_attempts{4};
+
+        static void DeleteVersion(void* version) { delete static_cast<Version*>(version); }
+        static Version* Next(Version const* version, int level) noexcept {
+            return version->links_[level].load(std::memory_order_acquire);
+        }
+        Version* First() const noexcept { return Next(begin_sentinel_, 0); }
+        /// @brief  Returns true if version orders before (key, sequence).
+        ///         Versions of a key are ordered newest first.
+        bool Before(Version const* version, K const& key, std::uint64_t sequence) const {
+            return compare_(version->key_, key)
+                || (!compare_(key, version->key_) && version->sequence_ > sequence);
+        }
+        /// @brief  Descend to the first version not before (key, sequence):
+        ///         the newest version of key a snapshot at sequence can see,
+        ///         if there is one
+        Version* Seek(K const& key, std::uint64_t sequence) const;
+        /// @brief  Returns the version of key a snapshot at sequence sees,
+        ///         nullptr if there is none or it is a tombstone. The caller
+        ///         pins the epoch or holds the writer lock; a snapshot alone
+        ///         does not keep the versions passed on the way alive.
+        Version* FindVersion(K const& key, std::uint64_t sequence) const {
+            auto version = Seek(key, sequence);
+            if(version == end_sentinel_ || compare_(key, version->key_) || version->tombstone_) {
+                return nullptr;
+            }
+            return version;
+        }
+        /// @brief  Returns the first version of the key following the key of version
+        Version* NextKey(Version const* version) const {
+            auto next = Next(version, 0);
+            while(next != end_sentinel_ && !compare_(version->key_, next->key_)) {
+                next = Next(next, 0);
+            }
+            return next;
+        }
+        /// @brief  Starting at the first version of a key, returns the first
+        ///         version a snapshot at sequence sees that is not a tombstone
+        Version* SeekVisible(Version* version, std::uint64_t sequence) const {
+            while(version != end_sentinel_) {
+                if(version->sequence_ > sequence) {
+                    version = Next(version, 0);
+                }
+                else if(version->tombstone_) {
+                    version = NextKey(version);
+                }
+                else {
+                    break;
+                }
+            }
+            return version;
+        }
+        /// @brief  Link a new version ahead of the older versions of its key.
+        ///         Snapshots do not see it until it is published. The caller
+        ///         holds the writer lock.
+        void Append(K const& key, V const& value, bool tombstone);
+        /// @brief  Make the appended versions visible to new snapshots
+        /// @return The sequence number of the last appended version
+        std::uint64_t Publish() noexcept {
+            last_sequence_.store(next_sequence_, std::memory_order_release);
+            return next_sequence_;
+        }
+        void ReleaseSnapshot(std::uint64_t sequence) const {
+            std::lock_guard lock(snapshot_mutex_);
+            snapshots_.erase(snapshots_.find(sequence));
+        }
+
+        Version* begin_sentinel_{};
+        Version* end_sentinel_{};
+        int const max_level_{};
+        std::function<int(int)> gen_next_skip_level_{};
+        [[no_unique_address]] Compare compare_{};
+        std::atomic<std::uint64_t> last_sequence_{};
+        /// @brief  The sequence number of the last appended version, ahead
+        ///         of last_sequence_ while a batch is being written
+        std::uint64_t next_sequence_{};
+        std::atomic<std::size_t> versions_{};
+        std::mutex writer_mutex_;
+        mutable std::mutex snapshot_mutex_;
+        mutable std::multiset<std::uint64_t> snapshots_;
+        mutable internal::EpochDomain epoch_{};
+    };
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare>
+    requires SkipNodeArgs<K, V>
+    VersionedSkipList<K, V, Compare>::VersionedSkipList(int max_level,
+        std::function<int(int)> gen_next_skip_level, Compare compare)
+        : max_level_(std::clamp(max_level, 1, skip_list_level_limit))
+        , gen_next_skip_level_(std::move(gen_next_skip_level))
+        , compare_(std::move(compare))
+    {
+        begin_sentinel_ = new Version(max_level_ - 1, 0, false, K{}, V{});
+        end_sentinel_ = new Version(max_level_ - 1, 0, false, K{}, V{});
+
+        //  connect start and end nodes
+        for(auto& link : begin_sentinel_->links_) {
+            link.store(end_sentinel_, std::memory_order_relaxed);
+        }
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare>
+    requires SkipNodeArgs<K, V>
+    VersionedSkipList<K, V, Compare>::~VersionedSkipList() {
+        for(auto version = begin_sentinel_; version != end_sentinel_;) {
+            auto next = version->links_[0].load(std::memory_order_relaxed);
+            delete version;
+            version = next;
+        }
+        delete end_sentinel_;
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare>
+    requires SkipNodeArgs<K, V>
+    typename VersionedSkipList<K, V, Compare>::Version*
+    VersionedSkipList<K, V, Compare>::Seek(K const& key, std::uint64_t sequence) const {
+        auto current{begin_sentinel_};
+        Version* next{};
+
+        for(auto search_level = max_level_ - 1; search_level >= 0; search_level--) {
+            for(next = Next(current, search_level);
+                next != end_sentinel_ && Before(next, key, sequence);
+                next = Next(current, search_level)) {
+                current = next;
+            }
+        }
+
+        return next;
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare>
+    requires SkipNodeArgs<K, V>
+    void
+    VersionedSkipList<K, V, Compare>::Append(K const& key, V const& value, bool tombstone) {
+        auto const sequence = ++next_sequence_;
+
+        //  the writer is alone, so the predecessors cannot change under it
+        std::array<Version*, skip_list_level_limit> update;
+        auto current{begin_sentinel_};
+        for(auto current_level = max_level_ - 1; current_level >= 0; current_level--) {
+            for(auto next = Next(current, current_level);
+                next != end_sentinel_ && Before(next, key, sequence);
+                next = Next(current, current_level)) {
+                current = next;
+            }
+            update[current_level] = current;
+        }
+
+        //  publish bottom up: a reader that finds the version at any level
+        //  also finds it at level 0
+        auto version = new Version(std::clamp(gen_next_skip_level_(max_level_), 0, max_level_ - 1),
+            sequence, tombstone, key, value);
+        for(int i = 0; i <= version->top_level_; i++) {
+            version->links_[i].store(Next(update[i], i), std::memory_order_relaxed);
+        }
+        for(int i = 0; i <= version->top_level_; i++) {
+            update[i]->links_[i].store(version, std::memory_order_release);
+        }
+
+        versions_.fetch_add(1, std::memory_order_relaxed);
+    }
+    //  ------------------------------------------------------------------------
+    //
+    template<typename K, typename V, typename Compare>
+    requires SkipNodeArgs<K, V>
+    std::size_t
+    VersionedSkipList<K, V, Compare>::Collect() {
+        std::lock_guard lock(writer_mutex_);
+
+        //  a snapshot taken after this point sees at least the last write
+        std::uint64_t oldest{};
+        {
+            std::lock_guard snapshot_lock(snapshot_mutex_);
+            oldest = snapshots_.empty() ? last_sequence_.load(std::memory_order_relaxed) : *snapshots_.begin();
+        }
+
+        //  last[i] is the last version kept at level i, the predecessor at
+        //  level i of the version being examined
+        std::array<Version*, skip_list_level_limit> last;
+        last.fill(begin_sentinel_);
+        //  retired once the walk is done, so the group key stays readable
+        std::vector<Version*> removed;
+        Version const* key_of{};
+        bool retained{};
+
+        for(auto version = First(); version != end_sentinel_; version = Next(version, 0)) {
+            if(key_of == nullptr || compare_(key_of->key_, version->key_)) {
+                key_of = version;
+                retained = false;
+            }
+
+            //  the first version at or before the oldest snapshot is what
+            //  every snapshot sees at the latest; the ones after it are dead
+            bool remove{retained};
+            if(!retained && version->sequence_ <= oldest) {
+                retained = true;
+                remove = version->tombstone_;
+            }
+
+            if(remove) {
+                //  readers stepping through the version still find their way
+                //  on through its own links
+                for(int i = 0; i <= version->top_level_; i++) {
+                    last[i]->links_[i].store(Next(version, i), std::memory_order_release);
+                }
+                removed.push_back(version);
+            }
+            else {
+                for(int i = 0; i <= version->top_level_; i++) {
+                    last[i] = version;
+                }
+            }
+        }
+
+        for(auto version : removed) {
+            epoch_.Retire(version, &DeleteVersion);
+        }
+        versions_.fetch_sub(removed.size(), std::memory_order_relaxed);
+        epoch_.Collect();
+        return removed.size();
+    }
+}
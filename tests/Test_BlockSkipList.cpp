@@ -0,0 +1,164 @@
+#include    <BlockSkipList.h>
+#include    <SkipListGen.h>
+
+#include    <gtest/gtest.h>
+
+#include    <algorithm>
+#include    <map>
+#include    <random>
+#include    <ranges>
+#include    <string>
+#include    <vector>
+
+namespace {
+    using namespace pentifica::tbox;
+
+    constexpr int max_level{5};
+
+    /// @brief  Satisfied by the key types a BlockSkipList accepts
+    template<typename K>
+    concept BlockKey = requires { typename BlockSkipList<K, int>; };
+
+    /// @brief  Returns the pairs of a list in iteration order
+    template<typename BL>
+    std::vector<std::pair<int, int>> Contents(BL const& skip_list) {
+        std::vector<std::pair<int, int>> contents;
+        for(auto entry : skip_list) contents.emplace_back(entry.Key(), entry.Value());
+        return contents;
+    }
+}
+
+TEST(Test_BlockSkipList, test_init) {
+    using SkipListType = BlockSkipList<int, std::string>;
+    static_assert(std::forward_iterator<SkipListType::iterator>);
+    static_assert(std::forward_iterator<SkipListType::const_iterator>);
+    static_assert(std::ranges::forward_range<SkipListType const>);
+    static_assert(SkipListType::block_size == 32);
+    //  pairs are assigned as they move within a block
+    struct FixedKey {
+        int const key_{};
+        bool operator<(FixedKey const& other) const { return key_ < other.key_; }
+    };
+    static_assert(BlockKey<int>);
+    static_assert(!BlockKey<FixedKey>);
+
+    auto skip_list = SkipListType(max_level, SkipListLevelGenerator(.5, 1));
+    ASSERT_TRUE(skip_list.Empty());
+    ASSERT_EQ(0, skip_list.Size());
+    ASSERT_EQ(0, skip_list.Blocks());
+    ASSERT_TRUE(skip_list.begin() == skip_list.end());
+    ASSERT_EQ(std::nullopt, skip_list.Find(1));
+    ASSERT_EQ(SkipListError::ErrorVariant::KEY_NOT_FOUND, skip_list.Delete(1));
+    ASSERT_TRUE(skip_list.LowerBound(1) == skip_list.end());
+}
+
+TEST(Test_BlockSkipList, test_insert_find_delete) {
+    using SkipListType = BlockSkipList<int, std::string>;
+
+    auto skip_list = SkipListType(max_level, SkipListLevelGenerator(.5, 2));
+    for(int key = 0; key < 1000; ++key) {
+        ASSERT_TRUE(skip_list.InsertOrAssign(key, std::to_string(key)));
+    }
+    ASSERT_EQ(1000, skip_list.Size());
+    ASSERT_LT(skip_list.Blocks(), 1000 / (SkipListType::block_size / 2) + 2);
+    for(int key = 0; key < 1000; ++key) {
+        ASSERT_EQ(skip_list.Find(key), std::to_string(key));
+    }
+    ASSERT_EQ(std::nullopt, skip_list.Find(-1));
+    ASSERT_EQ(std::nullopt, skip_list.Find(1000));
+
+    ASSERT_FALSE(skip_list.InsertOrAssign(7, "seven"));
+    ASSERT_EQ(skip_list.Insert(8, "eight"), "eight");
+    ASSERT_EQ(*skip_list.Lookup(7), "seven");
+    ASSERT_EQ(skip_list.Find(8), "eight");
+    ASSERT_EQ(nullptr, skip_list.Lookup(-7));
+    ASSERT_EQ(1000, skip_list.Size());
+
+    for(int key = 0; key < 1000; ++key) {
+        ASSERT_EQ(SkipListError::ErrorVariant::NOERR, skip_list.Delete(key));
+        ASSERT_EQ(std::nullopt, skip_list.Find(key));
+    }
+    ASSERT_TRUE(skip_list.Empty());
+    ASSERT_EQ(0, skip_list.Blocks());
+    skip_list.Insert(3, "three");
+    ASSERT_EQ(skip_list.Find(3), "three");
+}
+
+TEST(Test_BlockSkipList, test_random_operations) {
+    //  small blocks split and merge often
+    using SkipListType = BlockSkipList<int, int, std::less<int>, 4>;
+
+    auto skip_list = SkipListType(max_level, SkipListLevelGenerator(.5, 3));
+    std::map<int, int> expected;
+    std::mt19937 rng(4);
+    std::uniform_int_distribution<int> keys(0, 2000);
+    for(int op = 0; op < 50000; ++op) {
+        auto key = keys(rng);
+        if(rng() % 3 == 0) {
+            auto erased = expected.erase(key);
+            ASSERT_EQ(erased != 0 ? SkipListError::ErrorVariant::NOERR : SkipListError::ErrorVariant::KEY_NOT_FOUND,
+                skip_list.Delete(key));
+        }
+        else {
+            auto inserted = expected.insert_or_assign(key, op).second;
+            ASSERT_EQ(inserted, skip_list.InsertOrAssign(key, op));
+        }
+        if(op % 5000 == 0) {
+            ASSERT_TRUE(std::ranges::equal(std::vector<std::pair<int, int>>(expected.begin(), expected.end()), Contents(skip_list)));
+        }
+    }
+    ASSERT_EQ(expected.size(), skip_list.Size());
+    ASSERT_TRUE(std::ranges::equal(std::vector<std::pair<int, int>>(expected.begin(), expected.end()), Contents(skip_list)));
+    for(int key = 0; key <= 2000; ++key) {
+        auto found = expected.find(key);
+        ASSERT_EQ(skip_list.Find(key), found != expected.end() ? std::optional(found->second) : std::nullopt);
+    }
+}
+
+TEST(Test_BlockSkipList, test_sparse_deletes) {
+    //  thinning the keys out keeps every block but the last half full
+    using SkipListType = BlockSkipList<int, int, std::less<int>, 16>;
+
+    auto skip_list = SkipListType(max_level, SkipListLevelGenerator(.5, 6));
+    for(int key = 0; key < 16000; ++key) skip_list.Insert(key, key);
+    for(int key = 0; key < 16000; ++key) {
+        if(key % 8 != 0) {
+            ASSERT_EQ(SkipListError::ErrorVariant::NOERR, skip_list.Delete(key));
+        }
+    }
+    ASSERT_EQ(2000, skip_list.Size());
+    ASSERT_LE(skip_list.Blocks(), 2000 / (SkipListType::block_size / 2) + 1);
+    ASSERT_TRUE(std::ranges::equal(std::views::iota(0, 2000) | std::views::transform([](int i) { return i * 8; }),
+        Contents(skip_list) | std::views::keys));
+    for(int key = 0; key < 16000; ++key) {
+        ASSERT_EQ(skip_list.Find(key), key % 8 == 0 ? std::optional(key) : std::nullopt);
+    }
+}
+
+TEST(Test_BlockSkipList, test_bounds_and_ranges) {
+    using SkipListType = BlockSkipList<int, int, std::less<int>, 8>;
+
+    auto skip_list = SkipListType(max_level, SkipListLevelGenerator(.5, 5));
+    for(int key = 0; key < 500; key += 5) skip_list.Insert(key, -key);
+
+    ASSERT_EQ(0, skip_list.LowerBound(-3)->Key());
+    ASSERT_EQ(10, skip_list.LowerBound(6)->Key());
+    ASSERT_EQ(10, skip_list.LowerBound(10)->Key());
+    ASSERT_EQ(-495, skip_list.LowerBound(495)->Value());
+    ASSERT_TRUE(skip_list.LowerBound(496) == skip_list.end());
+
+    std::vector<int> visited;
+    ASSERT_EQ(4, skip_list.ForEachInRange(12, 32, [&visited](auto const& entry) { visited.push_back(entry.Key()); }));
+    ASSERT_EQ((std::vector<int>{15, 20, 25, 30}), visited);
+    ASSERT_EQ(0, skip_list.ForEachInRange(600, 700, [](auto const&) {}));
+    ASSERT_EQ(3, skip_list.ForEachInRange(0, 500, [n = 0](auto const&) mutable { return ++n < 3; }));
+
+    //  values are modifiable through iterators, not through const iterators
+    for(auto entry : skip_list) entry.Value() = entry.Key();
+    SkipListType const& view = skip_list;
+    static_assert(std::is_const_v<std::remove_reference_t<decltype(view.begin()->Value())>>);
+    ASSERT_TRUE(std::ranges::all_of(view, [](auto entry) { return entry.Key() == entry.Value(); }));
+    SkipListType::const_iterator first = skip_list.begin();
+    ASSERT_TRUE(first == view.begin());
+    ASSERT_EQ(100, std::ranges::distance(view));
+}
@@ -0,0 +1,163 @@
+#include    <ConcurrentSkipList.h>
+#include    <SkipListGen.h>
+
+#include    <gtest/gtest.h>
+
+#include    <atomic>
+#include    <random>
+#include    <string>
+#include    <thread>
+#include    <vector>
+
+namespace {
+    using namespace pentifica::tbox;
+
+    constexpr int max_level{12};
+
+    /// @brief  Each writer thread draws levels from its own generator
+    int ThreadLevel(int levels) {
+        thread_local SkipListLevelGenerator generator(.5);
+        return generator(levels);
+    }
+}
+
+TEST(Test_ConcurrentSkipList, test_init) {
+    using SkipListType = ConcurrentSkipList<int, std::string>;
+
+    SkipListType skip_list(max_level, ThreadLevel);
+    ASSERT_TRUE(skip_list.Empty());
+    ASSERT_EQ(0, skip_list.Size());
+    ASSERT_EQ(std::nullopt, skip_list.Find(0));
+}
+
+TEST(Test_ConcurrentSkipList, test_insert_find_delete) {
+    using SkipListType = ConcurrentSkipList<std::string, std::string>;
+
+    SkipListType skip_list(max_level, ThreadLevel);
+
+    std::vector<std::tuple<std::string, std::string, size_t>> kv_pairs = {
+        {"hello", "world", 1},         {"something", "else", 2},
+        {"enter", "exit", 3},           {"the red fox", "jumped and played", 4},
+        {"hello", "world2", 4},        {"something", "other", 4},
+    };
+
+    for(auto const& [key, value, count] : kv_pairs) {
+        ASSERT_EQ(value, skip_list.Insert(key, value));
+        ASSERT_EQ(count, skip_list.Size());
+    }
+
+    ASSERT_EQ(skip_list.Find("hello"), "world2");
+    ASSERT_EQ(skip_list.Find("something"), "other");
+    ASSERT_EQ(skip_list.Find("enter"), "exit");
+    ASSERT_EQ(skip_list.Find("nonexistent"), std::nullopt);
+
+    ASSERT_EQ(SkipListError::NOERR, skip_list.Delete("hello"));
+    ASSERT_EQ(SkipListError::KEY_NOT_FOUND, skip_list.Delete("hello"));
+    ASSERT_EQ(skip_list.Find("hello"), std::nullopt);
+    ASSERT_EQ(3, skip_list.Size());
+}
+
+TEST(Test_ConcurrentSkipList, test_disjoint_writers) {
+    using SkipListType = ConcurrentSkipList<int, int>;
+    constexpr int nbr_threads{8};
+    constexpr int keys_per_thread{20000};
+
+    SkipListType skip_list(max_level, ThreadLevel);
+
+    //  each writer owns a key range; it inserts every key, verifies it, and
+    //  deletes the odd ones while the other writers are doing the same
+    auto writer = [&skip_list](int id) {
+        auto const first = id * keys_per_thread;
+        for(int key = first; key < first + keys_per_thread; ++key) {
+            skip_list.Insert(key, -key);
+        }
+        for(int key = first; key < first + keys_per_thread; ++key) {
+            ASSERT_EQ(skip_list.Find(key), -key);
+        }
+        for(int key = first + 1; key < first + keys_per_thread; key += 2) {
+            ASSERT_EQ(SkipListError::NOERR, skip_list.Delete(key));
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for(int i = 0; i < nbr_threads; ++i) {
+        threads.emplace_back(writer, i);
+    }
+    for(auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(nbr_threads * keys_per_thread / 2, skip_list.Size());
+    for(int key = 0; key < nbr_threads * keys_per_thread; ++key) {
+        if(key % 2 == 0) {
+            ASSERT_EQ(skip_list.Find(key), -key);
+        }
+        else {
+            ASSERT_EQ(skip_list.Find(key), std::nullopt);
+        }
+    }
+}
+
+TEST(Test_ConcurrentSkipList, test_contended_stress) {
+    using SkipListType = ConcurrentSkipList<int, int>;
+    constexpr int nbr_writers{6};
+    constexpr int nbr_readers{4};
+    constexpr int nbr_ops{50000};
+    constexpr int key_range{256};
+
+    SkipListType skip_list(max_level, ThreadLevel);
+    std::atomic<bool> done{};
+
+    //  writers hammer a small shared key range
+    auto writer = [&](unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> key_dist(0, key_range - 1);
+        for(int op = 0; op < nbr_ops; ++op) {
+            auto key = key_dist(rng);
+            if(rng() % 2) {
+                skip_list.Insert(key, key);
+            }
+            else {
+                skip_list.Delete(key);
+            }
+        }
+    };
+
+    //  readers must only ever observe values that were written for the key
+    auto reader = [&](unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> key_dist(0, key_range - 1);
+        while(!done.load(std::memory_order_relaxed)) {
+            auto key = key_dist(rng);
+            auto value = skip_list.Find(key);
+            if(value) {
+                ASSERT_EQ(key, *value);
+            }
+        }
+    };
+
+    std::vector<std::thread> writers;
+    std::vector<std::thread> readers;
+    for(int i = 0; i < nbr_readers; ++i) {
+        readers.emplace_back(reader, 100 + i);
+    }
+    for(int i = 0; i < nbr_writers; ++i) {
+        writers.emplace_back(writer, i);
+    }
+    for(auto& thread : writers) {
+        thread.join();
+    }
+    done = true;
+    for(auto& thread : readers) {
+        thread.join();
+    }
+
+    //  the size must agree with the keys that can actually be found
+    size_t found{};
+    for(int key = 0; key < key_range; ++key) {
+        if(skip_list.Find(key)) {
+            ++found;
+        }
+    }
+    ASSERT_EQ(found, skip_list.Size());
+}
@@ -192,4 +192,79 @@ TEST(Test_RingBuffer, test_multithread) {
     }
 
     ASSERT_TRUE(buffer.Empty());
-}
\ No newline at end of file
+}
+
+TEST(Test_RingBuffer, test_spsc_push_pop) {
+    using namespace pentifica::tbox;
+    constexpr size_t capacity{4};
+
+    RingBuffer<TestObject, RingBufferSpsc> buffer(capacity);
+    ASSERT_EQ(capacity, buffer.Capacity());
+    ASSERT_TRUE(buffer.Empty());
+    ASSERT_FALSE(buffer.TryPop());
+
+    //  go round the ring several times
+    size_t pushed{};
+    size_t popped{};
+    for(size_t round = 0; round < 5; ++round) {
+        while(buffer.TryPush(TestObject{pushed, std::to_string(pushed)})) {
+            ++pushed;
+        }
+        ASSERT_EQ(capacity, buffer.Size());
+        for(size_t i = 0; i < capacity - 1; ++i) {
+            auto const actual = buffer.TryPop();
+            ASSERT_TRUE(actual);
+            ASSERT_EQ(popped, actual.value().key_);
+            ASSERT_EQ(std::to_string(popped), actual.value().value_);
+            ++popped;
+        }
+        ASSERT_EQ(1, buffer.Size());
+    }
+
+    auto const last = buffer.Pop();
+    ASSERT_EQ(popped, last.key_);
+    ASSERT_TRUE(buffer.Empty());
+    ASSERT_FALSE(buffer.TryPop());
+
+    TestObject value{7, "seven"};
+    buffer.Push(value);
+    ASSERT_TRUE(value.value_.empty());
+    ASSERT_EQ("seven", buffer.Pop().value_);
+}
+
+TEST(Test_RingBuffer, test_spsc_multithread) {
+    using namespace pentifica::tbox;
+    constexpr size_t nbr_events{100000};
+    constexpr size_t capacity{64};
+
+    RingBuffer<TestObject, RingBufferSpsc> buffer(capacity);
+
+    std::thread server([&buffer] {
+        for(size_t event = 0; event < nbr_events; ++event) {
+            if(event % 16 == 0) {
+                buffer.Push({event, {}});
+            }
+            else {
+                while(!buffer.TryPush({event, {}})) std::this_thread::yield();
+            }
+        }
+    });
+
+    //  every event arrives once and in order
+    for(size_t expected = 0; expected < nbr_events; ++expected) {
+        if(expected % 16 == 8) {
+            ASSERT_EQ(expected, buffer.Pop().key_);
+        }
+        else {
+            auto actual = buffer.TryPop();
+            while(!actual) {
+                std::this_thread::yield();
+                actual = buffer.TryPop();
+            }
+            ASSERT_EQ(expected, actual.value().key_);
+        }
+    }
+
+    server.join();
+    ASSERT_TRUE(buffer.Empty());
+}
@@ -0,0 +1,147 @@
+#include    <ShardedSkipList.h>
+#include    <SkipListGen.h>
+
+#include    <gtest/gtest.h>
+
+#include    <map>
+#include    <random>
+#include    <string>
+#include    <thread>
+#include    <vector>
+
+namespace {
+    using namespace pentifica::tbox;
+
+    constexpr int max_level{8};
+
+    /// @brief  Every shard draws its levels from its own seeded generator
+    auto SeededLevels(std::size_t shard) { return SkipListFastLevelGenerator<>(shard + 1); }
+
+    /// @brief  Collect the keys visited by a scan
+    template<typename Scan>
+    std::vector<int> Keys(Scan&& scan) {
+        std::vector<int> keys;
+        scan([&keys](auto const& node) { keys.push_back(node.Key()); });
+        return keys;
+    }
+}
+
+TEST(Test_ShardedSkipList, test_range_router) {
+    auto router = SkipListRangeRouter<int>({100, 200, 300});
+    ASSERT_EQ(4, router.Shards());
+    ASSERT_EQ(0, router(-5));
+    ASSERT_EQ(0, router(99));
+    ASSERT_EQ(1, router(100));
+    ASSERT_EQ(2, router(250));
+    ASSERT_EQ(3, router(300));
+    ASSERT_EQ(3, router(1000));
+
+    auto hash = SkipListHashRouter<int>(8);
+    ASSERT_EQ(8, hash.Shards());
+    for(int key = 0; key < 100; ++key) ASSERT_LT(hash(key), 8);
+    ASSERT_EQ(1, SkipListHashRouter<int>(0).Shards());
+}
+
+TEST(Test_ShardedSkipList, test_operations) {
+    using SkipListType = ShardedSkipList<int, std::string>;
+
+    auto skip_list = SkipListType(SkipListRangeRouter<int>({100, 200, 300}), max_level, SeededLevels);
+    ASSERT_EQ(4, skip_list.Shards());
+    ASSERT_TRUE(skip_list.Empty());
+    ASSERT_EQ(std::nullopt, skip_list.Find(1));
+
+    for(int key = 0; key < 400; key += 2) {
+        ASSERT_TRUE(skip_list.InsertOrAssign(key, std::to_string(key)));
+    }
+    ASSERT_EQ(200, skip_list.Size());
+    for(std::size_t shard = 0; shard < skip_list.Shards(); ++shard) {
+        ASSERT_EQ(50, skip_list.ShardSize(shard));
+    }
+    ASSERT_FALSE(skip_list.InsertOrAssign(10, "ten"));
+    ASSERT_EQ(skip_list.Find(10), "ten");
+    ASSERT_FALSE(skip_list.TryEmplace(10, "10"));
+    ASSERT_EQ(skip_list.Find(10), "ten");
+    ASSERT_TRUE(skip_list.TryEmplace(11, "11"));
+    ASSERT_TRUE(skip_list.Contains(11));
+    ASSERT_FALSE(skip_list.Contains(13));
+
+    ASSERT_TRUE(skip_list.Update(11, [](std::string& value) { value += "!"; }));
+    ASSERT_EQ(skip_list.Find(11), "11!");
+    ASSERT_FALSE(skip_list.Update(13, [](std::string&) {}));
+
+    ASSERT_EQ(SkipListError::ErrorVariant::NOERR, skip_list.Delete(11));
+    ASSERT_EQ(SkipListError::ErrorVariant::KEY_NOT_FOUND, skip_list.Delete(11));
+    ASSERT_EQ(200, skip_list.Size());
+
+    //  a batch inserts new keys and replaces the values of existing ones
+    std::vector<std::pair<int, std::string>> batch{{399, "a"}, {1, "b"}, {0, "c"}, {1, "d"}, {250, "e"}};
+    ASSERT_EQ(2, skip_list.InsertBatch(batch));
+    ASSERT_EQ(202, skip_list.Size());
+    ASSERT_EQ(skip_list.Find(1), "d");
+    ASSERT_EQ(skip_list.Find(0), "c");
+}
+
+TEST(Test_ShardedSkipList, test_ordered_scans) {
+    //  ordered and hashed shards give the same scans
+    auto check = [](auto skip_list) {
+        std::vector<int> expected;
+        for(int key = 0; key < 1000; key += 3) {
+            skip_list.InsertOrAssign(key, key);
+            expected.push_back(key);
+        }
+        auto all = Keys([&skip_list](auto visitor) { return skip_list.ForEach(visitor); });
+        ASSERT_EQ(expected, all);
+
+        for(auto [first, last] : {std::pair{0, 1000}, {-50, 50}, {95, 405}, {250, 260}, {999, 2000}, {10, 10}, {20, 10}}) {
+            std::vector<int> in_range;
+            for(auto key : expected) {
+                if(key >= first && key < last) in_range.push_back(key);
+            }
+            auto visited = Keys([&](auto visitor) { return skip_list.ForEachInRange(first, last, visitor); });
+            ASSERT_EQ(in_range, visited);
+        }
+
+        //  a visitor returning false stops the scan
+        int seen{};
+        ASSERT_EQ(5, skip_list.ForEachInRange(100, 900, [&seen](auto const&) { return ++seen < 5; }));
+        ASSERT_EQ(5, seen);
+    };
+    check(ShardedSkipList<int, int>(SkipListRangeRouter<int>({250, 500, 750}), max_level, SeededLevels));
+    check(ShardedSkipList<int, int, SkipListHashRouter<int>>(SkipListHashRouter<int>(7), max_level, SeededLevels));
+}
+
+TEST(Test_ShardedSkipList, test_concurrent_writers) {
+    using SkipListType = ShardedSkipList<int, int, SkipListHashRouter<int>>;
+    constexpr int num_threads{8};
+    constexpr int keys_per_thread{5000};
+
+    auto skip_list = SkipListType(SkipListHashRouter<int>(16), max_level, SeededLevels);
+    {
+        std::vector<std::jthread> writers;
+        for(int thread = 0; thread < num_threads; ++thread) {
+            writers.emplace_back([&skip_list, thread] {
+                for(int key = thread; key < num_threads * keys_per_thread; key += num_threads) {
+                    skip_list.InsertOrAssign(key, key);
+                    if(key % 3 == 0) skip_list.Delete(key);
+                }
+            });
+        }
+        //  readers scan while the writers run
+        writers.emplace_back([&skip_list] {
+            for(int pass = 0; pass < 20; ++pass) {
+                int previous{-1};
+                skip_list.ForEach([&previous](auto const& node) {
+                    EXPECT_LT(previous, node.Key());
+                    previous = node.Key();
+                });
+            }
+        });
+    }
+
+    std::size_t expected{};
+    for(int key = 0; key < num_threads * keys_per_thread; ++key) {
+        ASSERT_EQ(skip_list.Contains(key), key % 3 != 0);
+        expected += key % 3 != 0;
+    }
+    ASSERT_EQ(expected, skip_list.Size());
+}
@@ -1,5 +1,7 @@
 #include    <SkipList.h>
 #include    <SkipListGen.h>
+#include    <SkipListArena.h>
+#include    <Generator.h>
 
 #include    <gtest/gtest.h>
 
@@ -9,6 +11,11 @@
 #include    <unordered_set>
 #include    <format>
 #include    <iostream>
+#include    <map>
+#include    <chrono>
+#include    <execution>
+#include    <atomic>
+#include    <ranges>
 
 namespace {
     using namespace pentifica::tbox;
@@ -16,6 +23,31 @@ namespace {
     constexpr int max_level{5};
     std::function<int(int)> level_generator = SkipListLevelGenerator(.5);
 
+    /// @brief  A list with both rank queries and reverse iteration
+    struct IndexableBidirectional : SkipListPolicy {
+        static constexpr bool indexable{true};
+        static constexpr bool bidirectional{true};
+    };
+    /// @brief  A clock the tests move by hand
+    struct ManualClock {
+        using duration = std::chrono::seconds;
+        using rep = duration::rep;
+        using period = duration::period;
+        using time_point = std::chrono::time_point<ManualClock>;
+        static constexpr bool is_steady{true};
+        static time_point now() noexcept { return current; }
+        static inline time_point current{};
+    };
+    /// @brief  An expiring list reading the manual clock
+    struct ManualExpiring : SkipListPolicy {
+        static constexpr bool expiring{true};
+        using clock_type = ManualClock;
+    };
+    /// @brief  A list whose searches prefetch
+    struct Prefetching : SkipListPolicy {
+        static constexpr bool prefetching{true};
+    };
+
     /// @brief Encapsulates a key
     /// @tparam T 
     template<typename T>
@@ -37,6 +69,20 @@ namespace {
         using Wrapper<std::string>::Wrapper;
     };
 
+    /// @brief  Counts how values are built
+    struct Counted {
+        Counted() = default;
+        explicit Counted(int value) : value_(value) { ++constructed; }
+        Counted(Counted const& other) : value_(other.value_) { ++copied; }
+        Counted(Counted&& other) noexcept : value_(other.value_) { ++moved; }
+        Counted& operator=(Counted const& other) { value_ = other.value_; ++copied; return *this; }
+        Counted& operator=(Counted&& other) noexcept { value_ = other.value_; ++moved; return *this; }
+        int value_{};
+        static inline int constructed{};
+        static inline int copied{};
+        static inline int moved{};
+    };
+
     using Key = std::string;
     using Value = std::string;
 
@@ -152,6 +198,76 @@ TEST(Test_SkipListLevelGenerator, test_values) {
         ASSERT_GT(max_level, level);
     }
 }
+
+TEST(Test_SkipListLevelGenerator, test_fast_values) {
+    using namespace pentifica::tbox;
+
+    SkipListFastLevelGenerator<> generator;
+
+    //  with p = 1/2 about half the nodes stay at level 0 and a quarter at level 1
+    constexpr int loops = 100000;
+    std::array<int, max_level> histogram{};
+    for(int i = 0; i < loops; i++) {
+        auto level = generator(max_level);
+        ASSERT_LE(0, level);
+        ASSERT_GT(max_level, level);
+        ++histogram[level];
+    }
+    ASSERT_NEAR(loops / 2, histogram[0], loops / 50);
+    ASSERT_NEAR(loops / 4, histogram[1], loops / 50);
+
+    //  p = 1/4 needs two zero bits per level
+    SkipListFastLevelGenerator<2> quarter;
+    histogram.fill(0);
+    for(int i = 0; i < loops; i++) {
+        ++histogram[quarter(max_level)];
+    }
+    ASSERT_NEAR(loops * 3 / 4, histogram[0], loops / 50);
+
+    //  the generator can be the list's own level generator type
+    using SkipListType = SkipList<int, int, std::less<int>, SkipListPolicy, SkipListFastLevelGenerator<>>;
+    auto skip_list = SkipListType(max_level, SkipListFastLevelGenerator<>{});
+    for(int key = 0; key < 100; key++) {
+        skip_list.Insert(key, -key);
+    }
+    ASSERT_EQ(100, skip_list.Size());
+    ASSERT_EQ(skip_list.Find(42), -42);
+}
+
+TEST(Test_SkipListLevelGenerator, test_seed) {
+    using namespace pentifica::tbox;
+
+    //  the same seed gives the same levels, and Seed() restarts the sequence
+    auto draw = [](auto& generator) {
+        std::vector<int> levels(200);
+        for(auto& level : levels) level = generator(max_level);
+        return levels;
+    };
+    SkipListLevelGenerator first(.5, 42);
+    SkipListLevelGenerator second(.5, 42);
+    auto const levels = draw(first);
+    ASSERT_EQ(levels, draw(second));
+    first.Seed(42);
+    ASSERT_EQ(levels, draw(first));
+    SkipListLevelGenerator other(.5, 43);
+    ASSERT_NE(levels, draw(other));
+
+    SkipListFastLevelGenerator<> fast(42);
+    auto const fast_levels = draw(fast);
+    fast.Seed(42);
+    ASSERT_EQ(fast_levels, draw(fast));
+
+    //  lists built by the same operations from the same seed have the same layout
+    auto build = [] {
+        auto skip_list = SkipList<int, int>(max_level, SkipListLevelGenerator(.5, 7));
+        for(int key = 0; key < 100; key++) skip_list.Insert((key * 37) % 101, key);
+        for(int key = 0; key < 100; key += 3) skip_list.Delete(key);
+        std::vector<int> layout;
+        for(auto const& node : skip_list) layout.push_back(node.Level());
+        return layout;
+    };
+    ASSERT_EQ(build(), build());
+}
 TEST(Test_SkipListNode, test_init) {
     using namespace pentifica::tbox;
     using SkipListNodeType = SkipListNode<Key, Value>;
@@ -160,11 +276,45 @@ TEST(Test_SkipListNode, test_init) {
     const Value value{"value"};
     constexpr size_t current_level{5};
 
-    SkipListNodeType node(current_level, key, value);
+    auto node = SkipListNodeType::Create(current_level, key, value);
+
+    ASSERT_EQ(current_level, node->Level());
+    ASSERT_EQ(key, node->Key());
+    ASSERT_EQ(value, node->Value());
+    ASSERT_EQ(current_level + 1, node->Links().size());
+    for(auto link : node->Links()) {
+        ASSERT_EQ(nullptr, link);
+    }
+
+    SkipListNodeType::Destroy(node);
+}
+
+TEST(Test_SkipListArena, test_reuse) {
+    using namespace pentifica::tbox;
+
+    constexpr std::size_t slab_size{1024};
+    SkipListArena arena(slab_size);
+    ASSERT_EQ(0, arena.Footprint());
+
+    //  blocks are carved from one slab and are suitably aligned
+    auto first = arena.Allocate(40, 1);
+    auto second = arena.Allocate(40, 1);
+    ASSERT_NE(first, second);
+    ASSERT_EQ(0, reinterpret_cast<std::uintptr_t>(first) % SkipListArena::block_alignment);
+    ASSERT_EQ(0, reinterpret_cast<std::uintptr_t>(second) % SkipListArena::block_alignment);
+    ASSERT_EQ(slab_size, arena.Footprint());
+
+    //  released blocks are reused by the same size class only
+    arena.Deallocate(first, 1);
+    ASSERT_NE(first, arena.Allocate(24, 0));
+    ASSERT_EQ(first, arena.Allocate(40, 1));
 
-    ASSERT_EQ(current_level, node.Level());
-    ASSERT_EQ(key, node.Key());
-    ASSERT_EQ(value, node.Value());
+    //  oversized requests get a slab of their own
+    arena.Allocate(2 * slab_size, 5);
+    ASSERT_EQ(3 * slab_size, arena.Footprint());
+
+    arena.Release();
+    ASSERT_EQ(0, arena.Footprint());
 }
 
 TEST(Test_SkipList, test_init) {
@@ -325,4 +475,919 @@ TEST(Test_SkipList, test_iter_traverse) {
         ASSERT_EQ(actual.Key(), expected_key);
         ASSERT_EQ(actual.Value(), expected_value);
     }
-}
\ No newline at end of file
+}
+
+TEST(Test_SkipList, test_bounds) {
+    using namespace pentifica::tbox;
+    using SkipListType = SkipList<int, std::string>;
+
+    auto skip_list = SkipListType(max_level, level_generator);
+    for(int key = 0; key < 100; key += 10) {
+        skip_list.Insert(key, std::to_string(key));
+    }
+
+    //  key, expected lower bound, expected upper bound (-1 => end())
+    std::vector<std::tuple<int, int, int>> test_cases = {
+        {-5, 0, 0},     {0, 0, 10},     {5, 10, 10},
+        {50, 50, 60},   {90, 90, -1},   {95, -1, -1},
+    };
+
+    for(auto const& [key, lower, upper] : test_cases) {
+        auto lower_it = skip_list.LowerBound(key);
+        auto upper_it = skip_list.UpperBound(key);
+        if(lower < 0) {
+            ASSERT_EQ(lower_it, skip_list.end());
+        }
+        else {
+            ASSERT_EQ(lower, lower_it->Key());
+        }
+        if(upper < 0) {
+            ASSERT_EQ(upper_it, skip_list.end());
+        }
+        else {
+            ASSERT_EQ(upper, upper_it->Key());
+        }
+
+        auto [first, last] = skip_list.EqualRange(key);
+        ASSERT_EQ(first, lower_it);
+        ASSERT_EQ(last, upper_it);
+        ASSERT_EQ(key % 10 == 0 && key >= 0 && key < 100, first != last);
+    }
+
+    auto const& const_list = skip_list;
+    ASSERT_EQ(30, const_list.LowerBound(25)->Key());
+    ASSERT_EQ(const_list.UpperBound(90), const_list.end());
+}
+
+TEST(Test_SkipList, test_for_each_in_range) {
+    using namespace pentifica::tbox;
+    using SkipListType = SkipList<int, int>;
+
+    auto skip_list = SkipListType(max_level, level_generator);
+    for(int key = 0; key < 1000; ++key) {
+        skip_list.Insert(key, key * 2);
+    }
+
+    std::vector<int> visited;
+    auto count = skip_list.ForEachInRange(100, 110, [&visited](auto const& node) {
+        visited.push_back(node.Value());
+    });
+    ASSERT_EQ(10, count);
+    ASSERT_EQ(10, visited.size());
+    for(int i = 0; i < 10; ++i) {
+        ASSERT_EQ((100 + i) * 2, visited[i]);
+    }
+
+    //  a visitor returning false ends the scan
+    count = skip_list.ForEachInRange(500, 1000, [](auto const& node) {
+        return node.Key() < 504;
+    });
+    ASSERT_EQ(5, count);
+
+    ASSERT_EQ(0, skip_list.ForEachInRange(2000, 3000, [](auto const&) {}));
+    ASSERT_EQ(0, skip_list.ForEachInRange(10, 10, [](auto const&) {}));
+}
+
+TEST(Test_SkipList, test_bulk_load) {
+    using namespace pentifica::tbox;
+    using SkipListType = SkipList<int, int>;
+    constexpr int num_kv_pairs{10000};
+
+    std::vector<std::pair<int, int>> kv_pairs;
+    for(int key = 0; key < num_kv_pairs; ++key) {
+        kv_pairs.emplace_back(key, -key);
+    }
+
+    auto skip_list = SkipListType(max_level, level_generator);
+    ASSERT_EQ(num_kv_pairs, skip_list.BulkLoad(kv_pairs));
+    ASSERT_EQ(num_kv_pairs, skip_list.Size());
+
+    //  levels follow the position of the node in the input, capped by the
+    //  number of levels the list had grown to when the node was appended
+    int expected_key{};
+    for(auto const& node : skip_list) {
+        ASSERT_EQ(expected_key, node.Key());
+        ASSERT_EQ(-expected_key, node.Value());
+        auto levels = std::max(max_level, static_cast<int>(std::bit_width(static_cast<unsigned>(expected_key))));
+        ++expected_key;
+        ASSERT_EQ(std::min(std::countr_zero(static_cast<unsigned>(expected_key)), levels - 1),
+            node.Level());
+    }
+    ASSERT_EQ(num_kv_pairs, expected_key);
+
+    for(auto const& [key, value] : kv_pairs) {
+        ASSERT_EQ(skip_list.Find(key), value);
+    }
+}
+
+TEST(Test_SkipList, test_bulk_load_generator) {
+    using namespace pentifica::tbox;
+    using SkipListType = SkipList<int, std::string>;
+
+    auto squares = [](int count) -> Generator<std::pair<int, std::string>> {
+        for(int i = 0; i < count; ++i) {
+            auto kv_pair = std::make_pair(i * i, std::to_string(i));
+            co_yield kv_pair;
+        }
+    };
+
+    auto skip_list = SkipListType(max_level, level_generator);
+    ASSERT_EQ(100, skip_list.BulkLoad(squares(100)));
+    ASSERT_EQ(100, skip_list.Size());
+    ASSERT_EQ(skip_list.Find(49), "7");
+    ASSERT_EQ(skip_list.Find(50), std::nullopt);
+}
+
+TEST(Test_SkipList, test_bulk_load_unsorted) {
+    using namespace pentifica::tbox;
+    using SkipListType = SkipList<int, int>;
+
+    //  repeated keys update, out of order keys are inserted
+    std::vector<std::pair<int, int>> kv_pairs = {
+        {10, 1}, {20, 2}, {20, 3}, {5, 4}, {30, 5}, {25, 6}, {40, 7},
+    };
+
+    auto skip_list = SkipListType(max_level, level_generator);
+    ASSERT_EQ(kv_pairs.size(), skip_list.BulkLoad(kv_pairs));
+    ASSERT_EQ(6, skip_list.Size());
+
+    std::vector<std::pair<int, int>> expected = {
+        {5, 4}, {10, 1}, {20, 3}, {25, 6}, {30, 5}, {40, 7},
+    };
+    size_t index{};
+    for(auto const& node : skip_list) {
+        ASSERT_EQ(expected[index].first, node.Key());
+        ASSERT_EQ(expected[index].second, node.Value());
+        ++index;
+    }
+    ASSERT_EQ(expected.size(), index);
+
+    //  loading into a populated list inserts
+    std::vector<std::pair<int, int>> more = {{1, 8}, {50, 9}};
+    ASSERT_EQ(more.size(), skip_list.BulkLoad(more));
+    ASSERT_EQ(8, skip_list.Size());
+    ASSERT_EQ(skip_list.Find(1), 8);
+    ASSERT_EQ(skip_list.Find(50), 9);
+    ASSERT_EQ(skip_list.LowerBound(41)->Key(), 50);
+}
+
+TEST(Test_SkipList, test_insert_batch) {
+    using namespace pentifica::tbox;
+    using SkipListType = SkipList<int, int>;
+
+    auto skip_list = SkipListType(max_level, level_generator);
+    for(int key = 0; key < 1000; key += 3) {
+        skip_list.Insert(key, key);
+    }
+
+    //  sorted batches interleave with existing keys, repeat keys, and an out
+    //  of order key restarts the search
+    std::vector<std::pair<int, int>> batch;
+    for(int key = 500; key < 1500; key += 2) {
+        batch.emplace_back(key, -key);
+    }
+    batch.emplace_back(1498, 1);
+    batch.emplace_back(7, -7);
+    batch.emplace_back(8, -8);
+
+    std::map<int, int> expected;
+    for(auto const& node : skip_list) {
+        expected[node.Key()] = node.Value();
+    }
+    for(auto const& [key, value] : batch) {
+        expected[key] = value;
+    }
+
+    ASSERT_EQ(batch.size(), skip_list.InsertBatch(batch));
+    ASSERT_EQ(expected.size(), skip_list.Size());
+
+    auto it = skip_list.begin();
+    for(auto const& [key, value] : expected) {
+        ASSERT_NE(it, skip_list.end());
+        ASSERT_EQ(key, it->Key());
+        ASSERT_EQ(value, it->Value());
+        ++it;
+    }
+    ASSERT_EQ(it, skip_list.end());
+
+    //  every level stays ordered
+    for(int level = 0; level < max_level; ++level) {
+        for(auto node = skip_list.begin_sentinel_->Links()[level];
+            node != skip_list.end_sentinel_ && node->Links()[level] != skip_list.end_sentinel_;
+            node = node->Links()[level]) {
+            ASSERT_LT(node->Key(), node->Links()[level]->Key());
+        }
+    }
+}
+
+TEST(Test_SkipList, test_find_batch) {
+    using namespace pentifica::tbox;
+    using SkipListType = SkipList<int, int>;
+
+    auto skip_list = SkipListType(max_level, level_generator);
+    for(int key = 0; key < 1000; key += 2) {
+        skip_list.Insert(key, key * 10);
+    }
+
+    std::vector<int> keys = {-1, 0, 1, 2, 3, 500, 501, 998, 999, 1000, 4, 5, 6};
+    auto found = skip_list.FindBatch(keys);
+    ASSERT_EQ(keys.size(), found.size());
+    for(size_t i = 0; i < keys.size(); ++i) {
+        ASSERT_EQ(found[i], skip_list.Find(keys[i]));
+    }
+}
+
+TEST(Test_SkipList, test_heterogeneous_lookup) {
+    using namespace pentifica::tbox;
+    using SkipListType = SkipList<std::string, int, std::less<>>;
+
+    auto skip_list = SkipListType(max_level, level_generator);
+    skip_list.Insert("alpha", 1);
+    skip_list.Insert("beta", 2);
+    skip_list.Insert("gamma", 3);
+
+    //  probes compare against the stored keys without building a std::string
+    using namespace std::string_view_literals;
+    ASSERT_EQ(skip_list.Find("beta"sv), 2);
+    ASSERT_EQ(skip_list.Find("delta"sv), std::nullopt);
+    ASSERT_EQ(skip_list.LowerBound("b"sv)->Key(), "beta");
+    ASSERT_EQ(skip_list.UpperBound("beta"sv)->Key(), "gamma");
+    ASSERT_EQ(SkipListError::NOERR, skip_list.Delete("alpha"sv));
+    ASSERT_EQ(SkipListError::KEY_NOT_FOUND, skip_list.Delete("alpha"sv));
+    ASSERT_EQ(2, skip_list.Size());
+}
+
+TEST(Test_SkipList, test_compare) {
+    using namespace pentifica::tbox;
+
+    //  descending order
+    auto descending = SkipList<int, int, std::greater<int>>(max_level, level_generator);
+    for(int key : {3, 9, 1, 7, 5}) {
+        descending.Insert(key, key * 10);
+    }
+    std::vector<int> keys;
+    for(auto const& node : descending) {
+        keys.push_back(node.Key());
+    }
+    ASSERT_EQ((std::vector<int>{9, 7, 5, 3, 1}), keys);
+    ASSERT_EQ(descending.LowerBound(6)->Key(), 5);
+    ASSERT_EQ(descending.Find(7), 70);
+    ASSERT_EQ(SkipListError::NOERR, descending.Delete(7));
+    ASSERT_EQ(descending.Find(7), std::nullopt);
+
+    //  case insensitive keys; equivalent keys share a node
+    struct CaseInsensitive {
+        bool operator()(std::string const& lhs, std::string const& rhs) const {
+            return std::ranges::lexicographical_compare(lhs, rhs, {},
+                [](unsigned char c) { return std::tolower(c); },
+                [](unsigned char c) { return std::tolower(c); });
+        }
+    };
+    auto folded = SkipList<std::string, int, CaseInsensitive>(max_level, level_generator);
+    folded.Insert("Hello", 1);
+    folded.Insert("HELLO", 2);
+    folded.Insert("world", 3);
+    ASSERT_EQ(2, folded.Size());
+    ASSERT_EQ(folded.Find("hello"), 2);
+    ASSERT_EQ(folded.begin()->Key(), "Hello");
+    ASSERT_EQ(folded.Find("WORLD"), 3);
+
+    //  a key type with no comparison operators of its own
+    struct Point {
+        int x_{};
+        int y_{};
+    };
+    auto by_x_then_y = [](Point const& lhs, Point const& rhs) {
+        return std::tie(lhs.x_, lhs.y_) < std::tie(rhs.x_, rhs.y_);
+    };
+    auto points = SkipList<Point, int, decltype(by_x_then_y)>(max_level, level_generator, by_x_then_y);
+    points.Insert({1, 2}, 12);
+    points.Insert({0, 5}, 5);
+    points.Insert({1, 0}, 10);
+    ASSERT_EQ(points.Find(Point{1, 0}), 10);
+    ASSERT_EQ(points.Find(Point{1, 1}), std::nullopt);
+    ASSERT_EQ(points.begin()->Key().x_, 0);
+}
+
+TEST(Test_SkipList, test_emplace) {
+    using namespace pentifica::tbox;
+
+    using SkipListType = SkipList<std::string, Counted>;
+
+    auto skip_list = SkipListType(max_level, level_generator);
+
+    auto [first, inserted] = skip_list.TryEmplace("one", 1);
+    ASSERT_TRUE(inserted);
+    ASSERT_EQ("one", first->Key());
+    ASSERT_EQ(1, first->Value().value_);
+    ASSERT_EQ(1, Counted::constructed);
+    ASSERT_EQ(0, Counted::copied + Counted::moved);
+
+    //  an existing key constructs nothing
+    auto [again, inserted_again] = skip_list.TryEmplace("one", 5);
+    ASSERT_FALSE(inserted_again);
+    ASSERT_EQ(first, again);
+    ASSERT_EQ(1, again->Value().value_);
+    ASSERT_EQ(1, Counted::constructed);
+
+    //  Emplace replaces the value of an existing key
+    auto [replaced, inserted_replaced] = skip_list.Emplace("one", 7);
+    ASSERT_FALSE(inserted_replaced);
+    ASSERT_EQ(7, replaced->Value().value_);
+
+    //  InsertOrAssign moves the value in
+    Counted value(9);
+    auto const copies = Counted::copied;
+    auto [assigned, inserted_assigned] = skip_list.InsertOrAssign(std::string("two"), std::move(value));
+    ASSERT_TRUE(inserted_assigned);
+    ASSERT_EQ(9, assigned->Value().value_);
+    skip_list.InsertOrAssign("two", Counted(10));
+    ASSERT_EQ(10, skip_list.Find("two")->value_);
+    ASSERT_EQ(copies + 1, Counted::copied);     //  the copy is made by Find
+    ASSERT_EQ(2, skip_list.Size());
+}
+
+TEST(Test_SkipList, test_move_only_values) {
+    using namespace pentifica::tbox;
+    using SkipListType = SkipList<int, std::unique_ptr<int>>;
+
+    auto skip_list = SkipListType(max_level, level_generator);
+    skip_list.TryEmplace(1, std::make_unique<int>(10));
+    skip_list.InsertOrAssign(2, std::make_unique<int>(20));
+    skip_list.Emplace(1, new int(11));
+
+    ASSERT_EQ(2, skip_list.Size());
+    ASSERT_EQ(11, *skip_list.LowerBound(1)->Value());
+    ASSERT_EQ(20, *skip_list.LowerBound(2)->Value());
+}
+
+TEST(Test_SkipList, test_lookup_and_update) {
+    using namespace pentifica::tbox;
+    using SkipListType = SkipList<int, Counted>;
+
+    auto skip_list = SkipListType(max_level, level_generator);
+    for(int key = 0; key < 10; ++key) {
+        skip_list.TryEmplace(key, key * 100);
+    }
+
+    //  lookups hand out the stored value, not a copy
+    auto const copies = Counted::copied;
+    auto value = skip_list.Lookup(3);
+    ASSERT_NE(nullptr, value);
+    ASSERT_EQ(300, value->value_);
+    ASSERT_EQ(value, &skip_list.LowerBound(3)->Value());
+    ASSERT_EQ(nullptr, skip_list.Lookup(42));
+
+    auto const& const_list = skip_list;
+    ASSERT_EQ(value, const_list.Lookup(3));
+
+    //  updates happen in place
+    ASSERT_TRUE(skip_list.Update(3, [](Counted& counted) { counted.value_ += 1; }));
+    ASSERT_EQ(301, value->value_);
+    ASSERT_FALSE(skip_list.Update(42, [](Counted& counted) { counted.value_ = 0; }));
+    ASSERT_EQ(copies, Counted::copied);
+}
+
+TEST(Test_SkipList, test_indexable) {
+    using namespace pentifica::tbox;
+    using SkipListType = SkipList<int, int, std::less<int>, SkipListIndexable>;
+
+    //  a std::map is the reference for the order statistics
+    std::map<int, int> expected;
+    auto skip_list = SkipListType(max_level, level_generator);
+    auto verify = [&] {
+        ASSERT_EQ(expected.size(), skip_list.Size());
+        std::size_t index{};
+        for(auto const& [key, value] : expected) {
+            ASSERT_EQ(key, skip_list.At(index)->Key());
+            ASSERT_EQ(index, skip_list.Rank(key));
+            ++index;
+        }
+        ASSERT_EQ(skip_list.end(), skip_list.At(index));
+    };
+
+    std::mt19937 rng(7);
+    for(int i = 0; i < 500; ++i) {
+        auto key = static_cast<int>(rng() % 1000);
+        expected[key] = i;
+        skip_list.Insert(key, i);
+    }
+    verify();
+
+    for(int i = 0; i < 300; ++i) {
+        auto key = static_cast<int>(rng() % 1000);
+        ASSERT_EQ(expected.erase(key) == 1 ? SkipListError::NOERR : SkipListError::KEY_NOT_FOUND,
+            skip_list.Delete(key));
+    }
+    verify();
+
+    //  ranks of absent keys and range counts
+    ASSERT_EQ(0, skip_list.Rank(-1));
+    ASSERT_EQ(expected.size(), skip_list.Rank(1000));
+    auto count = static_cast<std::size_t>(std::distance(expected.lower_bound(250), expected.lower_bound(750)));
+    ASSERT_EQ(count, skip_list.CountInRange(250, 750));
+    ASSERT_EQ(0, skip_list.CountInRange(750, 250));
+
+    //  widths survive the bulk and batch load paths
+    std::vector<std::pair<int, int>> sorted;
+    for(int key = 0; key < 200; key += 2) {
+        sorted.emplace_back(key, key);
+    }
+    auto loaded = SkipListType(max_level, level_generator);
+    loaded.BulkLoad(sorted);
+    for(auto& [key, value] : sorted) {
+        ++key;
+    }
+    loaded.InsertBatch(sorted);
+    ASSERT_EQ(200, loaded.Size());
+    for(int key = 0; key < 200; ++key) {
+        ASSERT_EQ(key, loaded.At(key)->Key());
+        ASSERT_EQ(key, loaded.Rank(key));
+    }
+    auto const& const_list = loaded;
+    ASSERT_EQ(150, const_list.At(150)->Key());
+}
+
+TEST(Test_SkipList, test_level_growth) {
+    using namespace pentifica::tbox;
+    using SkipListType = SkipList<int, int, std::less<int>, SkipListIndexable, SkipListFastLevelGenerator<>>;
+    constexpr int num_keys{1 << 16};
+
+    //  a list started with a single level grows as it fills
+    auto skip_list = SkipListType(1, SkipListFastLevelGenerator<>(11));
+    ASSERT_EQ(1, skip_list.Levels());
+    for(int key = 0; key < num_keys; ++key) {
+        skip_list.Insert((key * 7919) % num_keys, key);
+    }
+    ASSERT_GE(skip_list.Levels(), 12);
+    ASSERT_LE(skip_list.Levels(), 17);
+    for(int key = 0; key < num_keys; key += 97) {
+        ASSERT_EQ(key, skip_list.At(key)->Key());
+        ASSERT_EQ(key, skip_list.Rank(key));
+    }
+
+    //  the search starts at the highest level still holding a node
+    for(int key = 0; key < num_keys; ++key) {
+        ASSERT_EQ(SkipListError::NOERR, skip_list.Delete(key));
+    }
+    ASSERT_TRUE(skip_list.Empty());
+    ASSERT_EQ(1, skip_list.Levels());
+    skip_list.Insert(1, 1);
+    ASSERT_EQ(skip_list.Find(1), 1);
+    ASSERT_EQ(0, skip_list.Rank(1));
+}
+
+TEST(Test_SkipList, test_stats) {
+    using namespace pentifica::tbox;
+    using SkipListType = SkipList<int, int, std::less<int>, SkipListInstrumented>;
+    constexpr int num_keys{4096};
+
+    auto skip_list = SkipListType(max_level, SkipListLevelGenerator(.5, 3));
+    auto empty = skip_list.Stats();
+    ASSERT_EQ(0, empty.size);
+    ASSERT_EQ(1, empty.levels);
+    ASSERT_EQ(0, empty.nodes_per_level[0]);
+    ASSERT_GT(empty.node_bytes, empty.tower_bytes);
+
+    for(int key = 0; key < num_keys; ++key) {
+        skip_list.Insert(key, key);
+    }
+    auto stats = skip_list.Stats();
+    ASSERT_EQ(num_keys, stats.size);
+    ASSERT_EQ(stats.levels, static_cast<int>(stats.nodes_per_level.size()));
+    ASSERT_EQ(num_keys, stats.nodes_per_level[0]);
+    ASSERT_LT(0, stats.nodes_per_level.back());
+    ASSERT_NEAR(num_keys / 2, stats.nodes_per_level[1], num_keys / 10);
+    ASSERT_GE(stats.arena_bytes, stats.node_bytes);
+    ASSERT_GE(stats.max_find_hops, stats.average_find_hops);
+
+    //  the structural hop counts agree with what the searches record
+    skip_list.ResetCounters();
+    for(int key = 0; key < num_keys; ++key) {
+        ASSERT_EQ(skip_list.Find(key), key);
+    }
+    auto const& counters = skip_list.Counters();
+    ASSERT_EQ(num_keys, counters.searches);
+    ASSERT_DOUBLE_EQ(stats.average_find_hops, static_cast<double>(counters.hops) / num_keys);
+    ASSERT_EQ(stats.max_find_hops, counters.max_hops);
+    ASSERT_GE(counters.comparisons, counters.hops + num_keys);
+
+    skip_list.ResetCounters();
+    ASSERT_EQ(0, skip_list.Counters().searches);
+
+    //  an uninstrumented list carries no counters
+    static_assert(sizeof(SkipList<int, int>) < sizeof(SkipListType));
+}
+
+TEST(Test_SkipList, test_merge_union) {
+    using namespace pentifica::tbox;
+    using SkipListType = SkipList<int, std::string>;
+
+    auto to_map = [](auto const& skip_list) {
+        std::map<int, std::string> contents;
+        for(auto const& node : skip_list) contents.emplace(node.Key(), node.Value());
+        return contents;
+    };
+
+    //  a delta replaces the values of keys already in the base
+    auto base = SkipListType(max_level, SkipListLevelGenerator(.5, 1));
+    auto expected = std::map<int, std::string>{};
+    for(int key = 0; key < 1000; key += 2) {
+        base.Insert(key, "base");
+        expected[key] = "base";
+    }
+    {
+        auto delta = SkipListType(max_level, SkipListLevelGenerator(.5, 2));
+        for(int key = 500; key < 1500; key += 3) {
+            delta.Insert(key, "delta");
+            expected[key] = "delta";
+        }
+        std::size_t added{};
+        for(int key = 500; key < 1500; key += 3) {
+            added += key % 2 != 0 || key >= 1000;
+        }
+        ASSERT_EQ(added, base.Merge(delta));
+        ASSERT_TRUE(delta.Empty());
+        ASSERT_EQ(0, delta.Size());
+
+        //  the emptied delta is still usable
+        delta.Insert(7, "again");
+        ASSERT_EQ(delta.Find(7), "again");
+    }
+    //  the moved nodes outlive the list they came from
+    ASSERT_EQ(expected, to_map(base));
+    ASSERT_EQ(expected.size(), base.Size());
+
+    //  a union keeps the values already in the list
+    auto other = SkipListType(max_level, SkipListLevelGenerator(.5, 3));
+    other.Insert(0, "other");
+    other.Insert(-5, "other");
+    ASSERT_EQ(1, base.Union(other));
+    ASSERT_EQ(base.Find(0), "base");
+    ASSERT_EQ(base.Find(-5), "other");
+    ASSERT_EQ(0, base.Merge(base));
+
+    //  deleting and inserting recycles storage from either arena
+    for(int key = -5; key < 1500; ++key) {
+        base.Delete(key);
+    }
+    ASSERT_TRUE(base.Empty());
+    for(int key = 0; key < 100; ++key) {
+        base.Insert(key, "new");
+    }
+    ASSERT_EQ(100, base.Size());
+}
+
+TEST(Test_SkipList, test_intersect_difference) {
+    using namespace pentifica::tbox;
+    using SkipListType = SkipList<int, int, std::less<int>, SkipListIndexable>;
+
+    auto make = [](int first, int last, int step, unsigned seed) {
+        auto skip_list = SkipListType(max_level, SkipListLevelGenerator(.5, seed));
+        for(int key = first; key < last; key += step) skip_list.Insert(key, key);
+        return skip_list;
+    };
+    auto keys = [](SkipListType const& skip_list) {
+        std::vector<int> contents;
+        for(auto const& node : skip_list) contents.push_back(node.Key());
+        return contents;
+    };
+
+    auto evens = make(0, 60, 2, 1);
+    auto threes = make(0, 60, 3, 2);
+    auto intersection = make(0, 60, 2, 3);
+    ASSERT_EQ(20, intersection.Intersect(threes));
+    ASSERT_EQ((std::vector<int>{0, 6, 12, 18, 24, 30, 36, 42, 48, 54}), keys(intersection));
+    ASSERT_EQ(10, intersection.Size());
+    ASSERT_EQ(3, intersection.Rank(18));
+    ASSERT_EQ(42, intersection.At(7)->Key());
+
+    ASSERT_EQ(10, evens.Difference(threes));
+    ASSERT_EQ(20, evens.Size());
+    for(int key = 0; key < 60; key += 2) {
+        ASSERT_EQ(evens.Find(key).has_value(), key % 3 != 0);
+    }
+    ASSERT_EQ(4, evens.At(1)->Key());
+    ASSERT_EQ(3, evens.Rank(10));
+
+    ASSERT_EQ(20, evens.Difference(evens));
+    ASSERT_TRUE(evens.Empty());
+}
+
+TEST(Test_SkipList, test_split) {
+    using namespace pentifica::tbox;
+
+    //  the cut works the same for plain and indexable lists
+    auto check = [](auto skip_list, int cut) {
+        for(int key = 0; key < 1000; ++key) skip_list.Insert(key, -key);
+        auto upper = skip_list.Split(cut);
+        auto const kept = std::clamp(cut, 0, 1000);
+        ASSERT_EQ(kept, skip_list.Size());
+        ASSERT_EQ(1000 - kept, upper.Size());
+
+        int expected{};
+        for(auto const& node : skip_list) ASSERT_EQ(expected++, node.Key());
+        ASSERT_EQ(kept, expected);
+        for(auto const& node : upper) ASSERT_EQ(expected++, node.Key());
+        ASSERT_EQ(1000, expected);
+
+        //  both halves remain fully usable
+        skip_list.Insert(5000, 1);
+        upper.Insert(-1, 1);
+        ASSERT_EQ(skip_list.Find(5000), 1);
+        ASSERT_EQ(upper.Find(-1), 1);
+        if constexpr(decltype(upper)::policy_type::indexable) {
+            ASSERT_EQ(1000 - kept + 1, upper.Size());
+            ASSERT_EQ(-1, upper.At(0)->Key());
+            ASSERT_EQ(kept, skip_list.Rank(5000));
+        }
+        for(int key = -1; key < 5001; ++key) {
+            skip_list.Delete(key);
+            upper.Delete(key);
+        }
+        ASSERT_TRUE(skip_list.Empty());
+        ASSERT_TRUE(upper.Empty());
+    };
+    for(int cut : {-10, 0, 1, 250, 999, 1000, 2000}) {
+        check(SkipList<int, int>(max_level, SkipListLevelGenerator(.5, cut + 20)), cut);
+        check(SkipList<int, int, std::less<int>, SkipListIndexable>(max_level, SkipListLevelGenerator(.5, cut + 20)), cut);
+    }
+
+    //  the two halves draw different levels, the same ones on every run
+    auto layouts = [](auto make) {
+        auto lower = make();
+        auto upper = lower.Split(0);
+        auto again = make().Split(0);
+        for(int key = 0; key < 1000; ++key) {
+            lower.Insert(key, key);
+            upper.Insert(key, key);
+            again.Insert(key, key);
+        }
+        ASSERT_NE(lower.Stats().nodes_per_level, upper.Stats().nodes_per_level);
+        ASSERT_EQ(upper.Stats().nodes_per_level, again.Stats().nodes_per_level);
+    };
+    layouts([] { return SkipList<int, int>(max_level, SkipListLevelGenerator(.5, 7)); });
+    layouts([] { return SkipList<int, int>(max_level, SkipListFastLevelGenerator<>(7)); });
+    layouts([] {
+        return SkipList<int, int, std::less<int>, SkipListPolicy, SkipListFastLevelGenerator<>>(
+            max_level, SkipListFastLevelGenerator<>(7));
+    });
+}
+
+TEST(Test_SkipList, test_bidirectional) {
+    using namespace pentifica::tbox;
+    using SkipListType = SkipList<int, int, std::less<int>, SkipListBidirectional>;
+    static_assert(std::bidirectional_iterator<SkipListType::iterator>);
+    static_assert(std::bidirectional_iterator<SkipListType::const_iterator>);
+    static_assert(std::forward_iterator<SkipList<int, int>::iterator>);
+    static_assert(!std::bidirectional_iterator<SkipList<int, int>::iterator>);
+
+    //  walking backward visits the keys forward iteration does, reversed
+    auto check = [](auto const& skip_list) {
+        std::vector<int> forward, backward;
+        for(auto const& node : skip_list) forward.push_back(node.Key());
+        for(auto it = skip_list.rbegin(); it != skip_list.rend(); ++it) backward.push_back(it->Key());
+        std::ranges::reverse(backward);
+        ASSERT_EQ(forward, backward);
+        ASSERT_EQ(forward.size(), skip_list.Size());
+    };
+
+    auto skip_list = SkipListType(max_level, SkipListLevelGenerator(.5, 1));
+    ASSERT_TRUE(skip_list.rbegin() == skip_list.rend());
+    for(int key = 0; key < 500; ++key) skip_list.Insert(key, -key);
+    check(skip_list);
+
+    auto it = skip_list.end();
+    --it;
+    ASSERT_EQ(499, it->Key());
+    ASSERT_EQ(499, (it--)->Key());
+    ASSERT_EQ(498, it->Key());
+
+    //  the last few nodes, without walking the list
+    auto last = std::views::take(std::ranges::subrange(skip_list.rbegin(), skip_list.rend()), 3);
+    ASSERT_TRUE(std::ranges::equal(last | std::views::transform([](auto const& node) { return node.Key(); }),
+        std::vector<int>{499, 498, 497}));
+
+    for(int key = 0; key < 500; key += 3) skip_list.Delete(key);
+    skip_list.Delete(499);
+    check(skip_list);
+    ASSERT_EQ(497, skip_list.rbegin()->Key());
+
+    //  the backward links survive the operations that relink whole runs of nodes
+    auto other = SkipListType(max_level, SkipListLevelGenerator(.5, 2));
+    for(int key = 250; key < 1000; key += 5) other.Insert(key, key);
+    skip_list.Merge(other);
+    check(skip_list);
+    check(other);
+
+    auto upper = skip_list.Split(600);
+    check(skip_list);
+    check(upper);
+    ASSERT_EQ(595, skip_list.rbegin()->Key());
+    ASSERT_EQ(995, upper.rbegin()->Key());
+
+    auto filter = SkipListType(max_level, SkipListLevelGenerator(.5, 3));
+    for(int key = 0; key < 1000; key += 2) filter.Insert(key, key);
+    skip_list.Intersect(filter);
+    check(skip_list);
+    skip_list.Difference(filter);
+    check(skip_list);
+    ASSERT_TRUE(skip_list.Empty());
+
+    //  combined with the indexable policy the trailer holds both
+    auto indexed = SkipList<int, int, std::less<int>, IndexableBidirectional>(max_level, SkipListLevelGenerator(.5, 4));
+    std::vector<std::pair<int, int>> kv_pairs;
+    for(int key = 0; key < 1000; ++key) kv_pairs.emplace_back(key, key);
+    indexed.BulkLoad(kv_pairs);
+    check(indexed);
+    indexed.Insert(1000, 0);
+    indexed.Delete(500);
+    check(indexed);
+    ASSERT_EQ(999, indexed.Rank(1000));
+    ASSERT_EQ(501, indexed.At(500)->Key());
+    ASSERT_EQ(1000, std::prev(indexed.end())->Key());
+}
+
+TEST(Test_SkipList, test_iterator_conformance) {
+    using namespace pentifica::tbox;
+    using SkipListType = SkipList<int, int>;
+    static_assert(std::forward_iterator<SkipListType::iterator>);
+    static_assert(std::forward_iterator<SkipListType::const_iterator>);
+    static_assert(std::ranges::forward_range<SkipListType>);
+    static_assert(std::ranges::forward_range<SkipListType const>);
+    static_assert(std::is_same_v<SkipListType::const_iterator::reference, SkipListType::value_type const&>);
+    static_assert(std::is_same_v<std::ranges::range_reference_t<SkipListType const>, SkipListType::value_type const&>);
+    static_assert(std::is_convertible_v<SkipListType::iterator, SkipListType::const_iterator>);
+    static_assert(!std::is_convertible_v<SkipListType::const_iterator, SkipListType::iterator>);
+
+    auto skip_list = SkipListType(max_level, SkipListLevelGenerator(.5, 1));
+    for(int key = 0; key < 1000; ++key) skip_list.Insert(key, key * 2);
+    auto const& view = skip_list;
+
+    //  iterators and const iterators of a list interoperate
+    SkipListType::const_iterator first = skip_list.begin();
+    ASSERT_TRUE(first == view.begin());
+    ASSERT_TRUE(skip_list.begin() == view.cbegin());
+    ASSERT_TRUE(view.cend() == skip_list.end());
+    ASSERT_TRUE(SkipListType::iterator{} == SkipListType::iterator{});
+
+    //  the list feeds range pipelines directly
+    auto odd_values = view
+        | std::views::filter([](auto const& node) { return node.Key() % 2 != 0; })
+        | std::views::transform([](auto const& node) { return node.Value(); })
+        | std::views::take(3);
+    ASSERT_TRUE(std::ranges::equal(odd_values, std::vector<int>{2, 6, 10}));
+    ASSERT_EQ(500, std::ranges::count_if(view, [](auto const& node) { return node.Key() < 500; }));
+    auto found = std::ranges::find(view, 42, &SkipListType::value_type::Key);
+    ASSERT_EQ(84, found->Value());
+    ASSERT_TRUE(std::ranges::is_sorted(view, {}, &SkipListType::value_type::Key));
+
+    //  and parallel algorithms
+    std::atomic<long> sum{};
+    std::for_each(std::execution::par, view.begin(), view.end(),
+        [&sum](auto const& node) { sum += node.Value(); });
+    ASSERT_EQ(999 * 1000, sum);
+    std::for_each(std::execution::par, skip_list.begin(), skip_list.end(),
+        [](auto& node) { node.Value() = -node.Key(); });
+    ASSERT_EQ(-999 * 500, std::transform_reduce(std::execution::par, view.begin(), view.end(),
+        0L, std::plus<>{}, [](auto const& node) { return node.Value(); }));
+}
+
+TEST(Test_SkipList, test_find_interleaved) {
+    using namespace pentifica::tbox;
+
+    auto check = [](auto skip_list) {
+        for(int key = 0; key < 5000; key += 2) skip_list.Insert(key, -key);
+
+        //  any order, duplicates, misses, and more keys than one group
+        std::vector<int> keys;
+        std::mt19937 rng(9);
+        for(int i = 0; i < 3000; ++i) keys.push_back(static_cast<int>(rng() % 5100) - 50);
+        keys.push_back(keys.front());
+        auto found = skip_list.FindInterleaved(keys);
+        ASSERT_EQ(keys.size(), found.size());
+        for(std::size_t i = 0; i < keys.size(); ++i) {
+            ASSERT_EQ(skip_list.Find(keys[i]), found[i]);
+        }
+
+        ASSERT_TRUE(skip_list.FindInterleaved(std::vector<int>{}).empty());
+        ASSERT_EQ((std::vector<std::optional<int>>{-4, std::nullopt}),
+            skip_list.FindInterleaved(std::views::iota(4, 6)));
+    };
+    check(SkipList<int, int>(max_level, SkipListLevelGenerator(.5, 1)));
+    check(SkipList<int, int, std::less<int>, Prefetching>(max_level, SkipListLevelGenerator(.5, 1)));
+
+    //  the searches are counted like any other
+    auto instrumented = SkipList<int, int, std::less<int>, SkipListInstrumented>(max_level, SkipListLevelGenerator(.5, 2));
+    for(int key = 0; key < 100; ++key) instrumented.Insert(key, key);
+    instrumented.ResetCounters();
+    instrumented.FindInterleaved(std::vector<int>{5, 50, 500});
+    ASSERT_EQ(3, instrumented.Counters().searches);
+}
+
+TEST(Test_SkipList, test_expiry) {
+    using namespace pentifica::tbox;
+    using namespace std::chrono_literals;
+    using SkipListType = SkipList<int, std::string, std::less<int>, ManualExpiring>;
+    static_assert(std::is_same_v<SkipListType::time_point, ManualClock::time_point>);
+    ManualClock::current = {};
+    auto const start = ManualClock::now();
+
+    auto skip_list = SkipListType(max_level, SkipListLevelGenerator(.5, 1));
+    for(int key = 0; key < 100; ++key) {
+        skip_list.InsertOrAssign(key, std::to_string(key), start + std::chrono::seconds(key));
+    }
+    skip_list.Insert(1000, "forever");
+    ASSERT_EQ(101, skip_list.Size());
+    ASSERT_EQ(start + 10s, skip_list.ExpiryOf(10));
+    ASSERT_EQ(SkipListType::time_point::max(), skip_list.ExpiryOf(1000));
+
+    //  searches skip expired entries, and Find and Lookup delete them
+    ManualClock::current = start + 10s;
+    ASSERT_EQ(std::nullopt, skip_list.Find(5));
+    ASSERT_EQ(nullptr, skip_list.Lookup(6));
+    ASSERT_FALSE(skip_list.Update(7, [](std::string&) {}));
+    ASSERT_EQ(98, skip_list.Size());
+    ASSERT_EQ(nullptr, std::as_const(skip_list).Lookup(8));
+    ASSERT_EQ(std::nullopt, skip_list.ExpiryOf(8));
+    ASSERT_EQ(98, skip_list.Size());
+    ASSERT_EQ(skip_list.Find(11), "11");
+    ASSERT_EQ((std::vector<std::optional<std::string>>{std::nullopt, "50"}),
+        skip_list.FindInterleaved(std::vector<int>{9, 50}));
+    ASSERT_EQ((std::vector<std::optional<std::string>>{std::nullopt, "50"}),
+        skip_list.FindBatch(std::vector<int>{9, 50}));
+
+    //  eviction is bounded by the budget and goes soonest first
+    ASSERT_EQ(3, skip_list.EvictExpired(3));
+    ASSERT_EQ(95, skip_list.Size());
+    ASSERT_EQ(3, skip_list.begin()->Key());
+    //  the entries for 5, 6 and 7 are stale and use up budget
+    ASSERT_EQ(5, skip_list.EvictExpired(8));
+    ASSERT_EQ(90, skip_list.Size());
+    ASSERT_EQ(11, skip_list.begin()->Key());
+    ASSERT_EQ(0, skip_list.EvictExpired(100));
+
+    //  a refreshed entry keeps only its new expiry time
+    ASSERT_TRUE(skip_list.ExpireAt(20, start + 1000s));
+    ASSERT_FALSE(skip_list.ExpireAt(5, start + 1000s));
+    ManualClock::current = start + 50s;
+    ASSERT_EQ(skip_list.Find(20), "20");
+    ASSERT_EQ(39, skip_list.EvictExpired(100));
+    ASSERT_EQ(skip_list.Find(20), "20");
+    ASSERT_EQ(std::nullopt, skip_list.Find(21));
+
+    //  an expired entry given a new value is live again and never expires
+    ManualClock::current = start + 60s;
+    ASSERT_TRUE(skip_list.InsertOrAssign(55, "again").second);
+    ASSERT_TRUE(skip_list.TryEmplace(56, "again").second);
+    ASSERT_FALSE(skip_list.TryEmplace(70, "again").second);
+    ASSERT_EQ(SkipListType::time_point::max(), skip_list.ExpiryOf(55));
+    ASSERT_EQ(skip_list.Find(56), "again");
+    skip_list.InsertBatch(std::vector<std::pair<int, std::string>>{{57, "batch"}, {58, "batch"}});
+    skip_list.BulkLoad(std::vector<std::pair<int, std::string>>{{59, "bulk"}});
+    ASSERT_EQ(SkipListType::time_point::max(), skip_list.ExpiryOf(57));
+    ASSERT_EQ(SkipListType::time_point::max(), skip_list.ExpiryOf(59));
+    ASSERT_EQ(skip_list.Find(58), "batch");
+    ASSERT_EQ(skip_list.Find(59), "bulk");
+
+    //  expiry times travel with the nodes
+    auto upper = skip_list.Split(80);
+    auto other = SkipListType(max_level, SkipListLevelGenerator(.5, 2));
+    other.InsertOrAssign(500, "other", start + 70s);
+    skip_list.Merge(other);
+    ManualClock::current = start + 2000s;
+    ASSERT_EQ(26, skip_list.EvictExpired(100));
+    ASSERT_EQ(5, skip_list.Size());
+    ASSERT_EQ(std::nullopt, skip_list.Find(500));
+    ASSERT_EQ(std::nullopt, skip_list.Find(20));
+    ASSERT_EQ(skip_list.Find(55), "again");
+    ASSERT_EQ(skip_list.Find(57), "batch");
+    ASSERT_EQ(20, upper.EvictExpired(100));
+    ASSERT_EQ(1, upper.Size());
+    ASSERT_EQ(upper.Find(1000), "forever");
+}
+
+TEST(Test_SkipList, test_expiry_queue_bound) {
+    using namespace pentifica::tbox;
+    using namespace std::chrono_literals;
+    using SkipListType = SkipList<int, int, std::less<int>, ManualExpiring>;
+    ManualClock::current = {};
+    auto const start = ManualClock::now();
+
+    //  refreshing the same keys over and over does not grow the queue
+    //  without bound
+    auto skip_list = SkipListType(max_level, SkipListLevelGenerator(.5, 1));
+    for(int round = 1; round <= 1000; ++round) {
+        for(int key = 0; key < 10; ++key) {
+            skip_list.InsertOrAssign(key, round, start + std::chrono::seconds(round));
+        }
+    }
+    ASSERT_LE(skip_list.expiry_queue_.size(), 2 * skip_list.Size() + 64);
+
+    ManualClock::current = start + 999s;
+    ASSERT_EQ(0, skip_list.EvictExpired(1000));
+    ASSERT_EQ(10, skip_list.Size());
+    ManualClock::current = start + 1000s;
+    ASSERT_EQ(10, skip_list.EvictExpired(1000));
+    ASSERT_TRUE(skip_list.Empty());
+}
@@ -0,0 +1,160 @@
+#include    <SkipListFile.h>
+#include    <SkipListGen.h>
+
+#include    <gtest/gtest.h>
+
+#include    <cstdint>
+#include    <filesystem>
+#include    <fstream>
+#include    <vector>
+
+namespace {
+    using namespace pentifica::tbox;
+
+    constexpr int max_level{8};
+
+    /// @brief  A file in the temporary directory, removed when the test ends
+    struct TemporaryFile {
+        TemporaryFile(std::string const& name)
+            : path_(std::filesystem::temp_directory_path() / name)
+        {}
+        ~TemporaryFile() {
+            std::error_code ignored;
+            std::filesystem::remove(path_, ignored);
+        }
+        std::filesystem::path path_;
+    };
+
+    struct Sample {
+        std::uint32_t id_{};
+        double reading_{};
+        bool operator==(Sample const&) const = default;
+    };
+
+    /// @brief  An ordering chosen at run time, with no default
+    struct Direction {
+        explicit Direction(bool descending) : descending_(descending) {}
+        bool operator()(int lhs, int rhs) const { return descending_ ? rhs < lhs : lhs < rhs; }
+        bool descending_;
+    };
+}
+
+TEST(Test_SkipListFile, test_save_load) {
+    using SkipListType = SkipList<std::uint64_t, Sample>;
+    TemporaryFile file("Test_SkipListFile.test_save_load.skl");
+
+    SkipListType source(max_level, SkipListLevelGenerator(.5, 1));
+    for(std::uint64_t key = 0; key < 5000; ++key) {
+        source.Insert(key * 3, Sample{static_cast<std::uint32_t>(key), key / 2.0});
+    }
+    ASSERT_EQ(SkipListError::NOERR, SaveSkipList(source, file.path_));
+
+    SkipListType restored(max_level, SkipListLevelGenerator(.5, 2));
+    ASSERT_EQ(SkipListError::NOERR, LoadSkipList(restored, file.path_));
+    ASSERT_EQ(source.Size(), restored.Size());
+    auto expected = source.begin();
+    for(auto const& node : restored) {
+        ASSERT_EQ(expected->Key(), node.Key());
+        ASSERT_EQ(expected->Value(), node.Value());
+        ++expected;
+    }
+
+    //  an empty list round trips too
+    SkipListType empty(max_level, SkipListLevelGenerator(.5, 3));
+    ASSERT_EQ(SkipListError::NOERR, SaveSkipList(empty, file.path_));
+    SkipListType still_empty(max_level, SkipListLevelGenerator(.5, 4));
+    ASSERT_EQ(SkipListError::NOERR, LoadSkipList(still_empty, file.path_));
+    ASSERT_TRUE(still_empty.Empty());
+}
+
+TEST(Test_SkipListFile, test_view) {
+    using SkipListType = SkipList<int, int, std::greater<int>>;
+    TemporaryFile file("Test_SkipListFile.test_view.skl");
+
+    SkipListType source(max_level, SkipListLevelGenerator(.5, 1));
+    for(int key = 0; key < 100; key += 2) {
+        source.Insert(key, -key);
+    }
+    ASSERT_EQ(SkipListError::NOERR, SaveSkipList(source, file.path_));
+
+    SkipListFileView<int, int, std::greater<int>> view;
+    ASSERT_EQ(SkipListError::NOERR, view.Open(file.path_));
+    ASSERT_EQ(50, view.Size());
+    ASSERT_EQ(98, view.Keys().front());
+    ASSERT_EQ(view.Find(42), -42);
+    ASSERT_EQ(view.Find(43), std::nullopt);
+    ASSERT_EQ(view.Find(1000), std::nullopt);
+    ASSERT_EQ(view.Keys()[view.LowerBound(43)], 42);
+
+    //  ranges follow the list's order
+    std::vector<int> keys;
+    ASSERT_EQ(5, view.ForEachInRange(50, 40, [&keys](int key, int) { keys.push_back(key); }));
+    ASSERT_EQ((std::vector<int>{50, 48, 46, 44, 42}), keys);
+    ASSERT_EQ(2, view.ForEachInRange(50, 0, [](int key, int) { return key > 48; }));
+
+    //  the view outlives a move, and closing it empties it
+    auto moved = std::move(view);
+    ASSERT_TRUE(view.Empty());
+    ASSERT_EQ(moved.Find(0), 0);
+    moved.Close();
+    ASSERT_TRUE(moved.Empty());
+    ASSERT_EQ(moved.Find(0), std::nullopt);
+}
+
+TEST(Test_SkipListFile, test_errors) {
+    TemporaryFile file("Test_SkipListFile.test_errors.skl");
+    SkipListFileView<int, int> view;
+
+    ASSERT_EQ(SkipListError::IO_ERROR, view.Open(file.path_));
+
+    //  not a skip list file
+    {
+        std::ofstream out(file.path_, std::ios::binary);
+        out << "definitely not a skip list file, but long enough to hold a header";
+    }
+    ASSERT_EQ(SkipListError::BAD_FORMAT, view.Open(file.path_));
+
+    //  saved with other key and value types
+    SkipList<int, double> doubles(max_level, SkipListLevelGenerator(.5, 1));
+    doubles.Insert(1, 1.0);
+    ASSERT_EQ(SkipListError::NOERR, SaveSkipList(doubles, file.path_));
+    ASSERT_EQ(SkipListError::BAD_FORMAT, view.Open(file.path_));
+
+    //  truncated
+    SkipList<int, int> ints(max_level, SkipListLevelGenerator(.5, 1));
+    for(int key = 0; key < 100; ++key) {
+        ints.Insert(key, key);
+    }
+    ASSERT_EQ(SkipListError::NOERR, SaveSkipList(ints, file.path_));
+    ASSERT_EQ(SkipListError::NOERR, view.Open(file.path_));
+    view.Close();
+    std::filesystem::resize_file(file.path_, std::filesystem::file_size(file.path_) - 4);
+    ASSERT_EQ(SkipListError::BAD_FORMAT, view.Open(file.path_));
+
+    //  the directory does not exist
+    ASSERT_EQ(SkipListError::IO_ERROR, SaveSkipList(ints, file.path_ / "missing" / "list.skl"));
+}
+
+TEST(Test_SkipListFile, test_stateful_order) {
+    using SkipListType = SkipList<int, int, Direction>;
+    TemporaryFile file("Test_SkipListFile.test_stateful_order.skl");
+
+    SkipListType source(max_level, SkipListLevelGenerator(.5, 1), Direction(true));
+    for(int key = 0; key < 100; ++key) {
+        source.Insert(key, -key);
+    }
+    ASSERT_EQ(SkipListError::NOERR, SaveSkipList(source, file.path_));
+
+    //  the file is read in the order of the list it is loaded into
+    SkipListType restored(max_level, SkipListLevelGenerator(.5, 2), Direction(true));
+    ASSERT_EQ(SkipListError::NOERR, LoadSkipList(restored, file.path_));
+    ASSERT_EQ(100, restored.Size());
+    ASSERT_EQ(99, restored.begin()->Key());
+    ASSERT_EQ(restored.Find(42), -42);
+
+    SkipListFileView<int, int, Direction> view(Direction(true));
+    ASSERT_EQ(SkipListError::NOERR, view.Open(file.path_));
+    auto moved = std::move(view);
+    ASSERT_EQ(moved.Find(42), -42);
+    ASSERT_EQ(moved.Keys()[moved.LowerBound(42)], 42);
+}
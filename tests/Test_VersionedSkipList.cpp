@@ -0,0 +1,243 @@
+#include    <VersionedSkipList.h>
+#include    <SkipListGen.h>
+
+#include    <gtest/gtest.h>
+
+#include    <atomic>
+#include    <string>
+#include    <thread>
+#include    <utility>
+#include    <vector>
+
+namespace {
+    using namespace pentifica::tbox;
+
+    constexpr int max_level{8};
+
+    using VersionedType = VersionedSkipList<int, std::string>;
+
+    /// @brief  Collect the entries a snapshot sees
+    template<typename Snapshot>
+    std::vector<std::pair<int, std::string>> Entries(Snapshot const& snapshot) {
+        std::vector<std::pair<int, std::string>> entries;
+        for(auto const& version : snapshot) entries.emplace_back(version.Key(), version.Value());
+        return entries;
+    }
+}
+
+TEST(Test_VersionedSkipList, test_put_find_delete) {
+    VersionedType skip_list(max_level, SkipListLevelGenerator(.5, 1));
+    ASSERT_EQ(std::nullopt, skip_list.Find(1));
+    ASSERT_EQ(1, skip_list.Put(1, "one"));
+    ASSERT_EQ(2, skip_list.Put(2, "two"));
+    ASSERT_EQ(3, skip_list.Put(1, "uno"));
+    ASSERT_EQ("uno", skip_list.Find(1));
+    ASSERT_EQ("two", skip_list.Find(2));
+    ASSERT_EQ(3, skip_list.Versions());
+
+    ASSERT_EQ(SkipListError::ErrorVariant::NOERR, skip_list.Delete(1));
+    ASSERT_EQ(std::nullopt, skip_list.Find(1));
+    ASSERT_EQ(SkipListError::ErrorVariant::KEY_NOT_FOUND, skip_list.Delete(1));
+    ASSERT_EQ(SkipListError::ErrorVariant::KEY_NOT_FOUND, skip_list.Delete(3));
+    ASSERT_EQ(4, skip_list.Sequence());
+    ASSERT_EQ(4, skip_list.Versions());
+}
+
+TEST(Test_VersionedSkipList, test_snapshot_isolation) {
+    VersionedType skip_list(max_level, SkipListLevelGenerator(.5, 2));
+    skip_list.Put(1, "a1");
+    skip_list.Put(2, "b1");
+    skip_list.Put(3, "c1");
+
+    auto const before = skip_list.TakeSnapshot();
+    ASSERT_EQ(3, before.Sequence());
+    skip_list.Put(2, "b2");
+    skip_list.Delete(3);
+    skip_list.Put(4, "d1");
+    auto const after = skip_list.TakeSnapshot();
+
+    using Entry = std::pair<int, std::string>;
+    ASSERT_EQ((std::vector<Entry>{{1, "a1"}, {2, "b1"}, {3, "c1"}}), Entries(before));
+    ASSERT_EQ((std::vector<Entry>{{1, "a1"}, {2, "b2"}, {4, "d1"}}), Entries(after));
+    ASSERT_EQ("b1", before.Find(2));
+    ASSERT_EQ("c1", before.Find(3));
+    ASSERT_EQ(std::nullopt, before.Find(4));
+    ASSERT_EQ(std::nullopt, after.Find(3));
+    ASSERT_EQ("d1", *after.Lookup(4));
+    ASSERT_EQ(nullptr, after.Lookup(5));
+
+    ASSERT_EQ(2, after.LowerBound(2)->Key());
+    ASSERT_EQ(4, after.LowerBound(3)->Key());
+    ASSERT_EQ(after.end(), after.LowerBound(5));
+    std::vector<int> keys;
+    ASSERT_EQ(2, before.ForEachInRange(2, 4, [&keys](auto const& version) { keys.push_back(version.Key()); }));
+    ASSERT_EQ((std::vector<int>{2, 3}), keys);
+    ASSERT_EQ(1, after.ForEachInRange(1, 5, [](auto const&) { return false; }));
+}
+
+TEST(Test_VersionedSkipList, test_collect) {
+    VersionedType skip_list(max_level, SkipListLevelGenerator(.5, 3));
+    for(int round = 0; round < 4; ++round) {
+        for(int key = 0; key < 100; ++key) skip_list.Put(key, std::to_string(round));
+    }
+    ASSERT_EQ(400, skip_list.Versions());
+
+    {
+        //  a snapshot keeps the versions it sees
+        auto const snapshot = skip_list.TakeSnapshot();
+        for(int key = 0; key < 100; key += 2) skip_list.Put(key, "4");
+        for(int key = 1; key < 100; key += 2) skip_list.Delete(key);
+        ASSERT_EQ(500, skip_list.Versions());
+        ASSERT_EQ(300, skip_list.Collect());
+        ASSERT_EQ(200, skip_list.Versions());
+        ASSERT_EQ(1, skip_list.Snapshots());
+        for(auto const& version : snapshot) ASSERT_EQ("3", version.Value());
+        ASSERT_EQ(100, Entries(snapshot).size());
+    }
+    ASSERT_EQ(0, skip_list.Snapshots());
+
+    //  with no snapshot left only the latest versions stay, and the
+    //  tombstones go with the versions they hid
+    ASSERT_EQ(150, skip_list.Collect());
+    ASSERT_EQ(50, skip_list.Versions());
+    auto const snapshot = skip_list.TakeSnapshot();
+    auto const entries = Entries(snapshot);
+    ASSERT_EQ(50, entries.size());
+    for(auto const& [key, value] : entries) {
+        ASSERT_EQ(0, key % 2);
+        ASSERT_EQ("4", value);
+    }
+    ASSERT_EQ(0, skip_list.Collect());
+}
+
+TEST(Test_VersionedSkipList, test_concurrent_snapshots) {
+    //  every batch keeps the sum of the values at zero, so a consistent
+    //  view always sums to zero
+    constexpr int keys{64};
+    VersionedSkipList<int, long> skip_list(max_level, SkipListLevelGenerator(.5, 4));
+    for(int key = 0; key < keys; ++key) skip_list.Put(key, 0);
+
+    std::atomic<bool> done{};
+    std::atomic<std::size_t> scans{};
+    std::vector<std::jthread> readers;
+    for(int reader = 0; reader < 2; ++reader) {
+        readers.emplace_back([&] {
+            while(!done.load()) {
+                auto const snapshot = skip_list.TakeSnapshot();
+                long sum{};
+                int count{};
+                for(auto const& version : snapshot) {
+                    sum += version.Value();
+                    ++count;
+                }
+                //  a second pass over the same snapshot sees the same view
+                long again{};
+                snapshot.ForEachInRange(0, keys, [&again](auto const& version) { again += version.Value(); });
+                EXPECT_EQ(0, sum);
+                EXPECT_EQ(sum, again);
+                EXPECT_EQ(keys, count);
+                scans.fetch_add(1);
+            }
+        });
+    }
+
+    {
+        std::jthread writer([&] {
+            for(int i = 0; i < 20000 || scans.load() < 10; ++i) {
+                //  move one unit between two keys as one batch
+                auto const from = i % keys;
+                auto const to = (i * 7 + 1) % keys;
+                if(from == to) continue;
+                skip_list.PutBatch(std::vector<std::pair<int, long>>{
+                    {from, skip_list.Find(from).value() - 1}, {to, skip_list.Find(to).value() + 1}});
+                if(i % 1000 == 0) skip_list.Collect();
+            }
+        });
+    }
+    done = true;
+    readers.clear();
+    ASSERT_GT(scans.load(), 0);
+}
+
+TEST(Test_VersionedSkipList, test_snapshot_find_during_collect) {
+    //  a snapshot's descent steps through older versions of other keys,
+    //  which Collect removes while it runs
+    constexpr int keys{256};
+    VersionedSkipList<int, long> skip_list(max_level, SkipListLevelGenerator(.5, 5));
+    for(int key = 0; key < keys; ++key) skip_list.Put(key, key);
+
+    std::atomic<bool> done{};
+    std::atomic<std::size_t> finds{};
+    std::vector<std::jthread> readers;
+    for(int reader = 0; reader < 2; ++reader) {
+        readers.emplace_back([&, reader] {
+            for(int key = reader; !done.load(); key = (key + 13) % keys) {
+                auto const snapshot = skip_list.TakeSnapshot();
+                auto const value = snapshot.Find(key);
+                EXPECT_TRUE(value.has_value());
+                EXPECT_EQ(key, value.value_or(key) % keys);
+                auto const again = snapshot.Lookup(key);
+                ASSERT_NE(nullptr, again);
+                EXPECT_EQ(value, *again);
+                finds.fetch_add(1);
+            }
+        });
+    }
+
+    {
+        std::jthread writer([&] {
+            for(long i = 0; i < 20000 || finds.load() < 1000; ++i) {
+                auto const key = static_cast<int>(i % keys);
+                skip_list.Put(key, key + keys * i);
+                if(i % 100 == 0) skip_list.Collect();
+            }
+        });
+    }
+    done = true;
+    readers.clear();
+    ASSERT_GT(finds.load(), 0);
+    skip_list.Collect();
+    ASSERT_EQ(keys, skip_list.Versions());
+}
+
+TEST(Test_VersionedSkipList, test_find_during_collect) {
+    //  with no snapshot held, Collect keeps only the newest version of a
+    //  key, so a Find that loaded an earlier sequence must still find it
+    constexpr int keys{64};
+    VersionedSkipList<int, long> skip_list(max_level, SkipListLevelGenerator(.5, 6));
+    for(int key = 0; key < keys; ++key) skip_list.Put(key, key);
+
+    std::atomic<bool> done{};
+    std::atomic<std::size_t> finds{};
+    std::atomic<std::size_t> misses{};
+    std::jthread reader([&] {
+        //  nor may it find a version older than one it found before
+        std::vector<long> last(keys);
+        while(!done.load()) {
+            for(int key = 0; key < keys; ++key) {
+                auto const value = skip_list.Find(key);
+                if(!value.has_value()) {
+                    misses.fetch_add(1);
+                    continue;
+                }
+                EXPECT_EQ(key, *value % keys);
+                EXPECT_LE(last[key], *value);
+                last[key] = *value;
+            }
+            finds.fetch_add(keys);
+        }
+    });
+
+    {
+        std::jthread writer([&] {
+            for(long i = 0; i < 200000 || finds.load() < 100000; ++i) {
+                auto const key = static_cast<int>(i % keys);
+                skip_list.Put(key, key + keys * i);
+                if(i % 8 == 0) skip_list.Collect();
+            }
+        });
+    }
+    done = true;
+    reader.join();
+    ASSERT_EQ(0, misses.load());
+}